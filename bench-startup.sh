@@ -0,0 +1,68 @@
+#!/usr/bin/env zsh
+# Startup time of the GTK switcher against the lean Wayland build. Each build
+# is launched RUNS times with --exit-on-first-frame; the table shows wall time
+# to exit and the switcher's own open_to_first_frame metric.
+#
+#   ./bench-startup.sh
+#
+# Uses the running compositor when WAYLAND_DISPLAY is set, otherwise a
+# headless sway (WLR_BACKENDS=headless) in a scratch runtime directory. With
+# hypr-mock-server built, the switchers talk to it instead of a live Hyprland.
+set -euo pipefail
+zmodload zsh/datetime # EPOCHREALTIME
+
+GTK_BUILD=${GTK_BUILD:-./ely-workspace-switcher}
+LEAN_BUILD=${LEAN_BUILD:-./ely-workspace-switcher-lean}
+MOCK=${MOCK:-./hypr-mock-server}
+RUNS=${RUNS:-20}
+
+for build in $GTK_BUILD $LEAN_BUILD; do
+    if [[ ! -x "$build" ]]; then
+        echo "[bench-startup] $build not found, build it with 'make' and 'make lean'" >&2
+        exit 1
+    fi
+done
+
+pids=()
+scratch=$(mktemp -d)
+trap 'kill $pids 2>/dev/null; rm -rf $scratch' EXIT
+
+if [[ -z "${WAYLAND_DISPLAY:-}" ]]; then
+    export XDG_RUNTIME_DIR=$scratch
+    WLR_BACKENDS=headless WLR_LIBINPUT_NO_DEVICES=1 sway -c /dev/null >$scratch/sway.log 2>&1 &
+    pids+=($!)
+    for i in {1..50}; do
+        socket=($scratch/wayland-*(N=))
+        (( $#socket )) && break
+        sleep 0.1
+    done
+    if (( ! $#socket )); then
+        echo "[bench-startup] headless sway did not start, see $scratch/sway.log" >&2
+        exit 1
+    fi
+    export WAYLAND_DISPLAY=${socket[1]:t}
+fi
+
+if [[ -x "$MOCK" ]]; then
+    "$MOCK" serve fixtures/session --signature=bench-startup >/dev/null &
+    pids+=($!)
+    export HYPRLAND_INSTANCE_SIGNATURE=bench-startup
+    sleep 0.2
+fi
+
+printf "%-32s %10s %10s %14s %14s\n" build wall_p50 wall_p90 first_frame_p50 first_frame_p90
+for build in $GTK_BUILD $LEAN_BUILD; do
+    walls=()
+    frames=()
+    for run in {1..$RUNS}; do
+        start=$EPOCHREALTIME
+        "$build" --exit-on-first-frame --metrics=$scratch/metrics.json >/dev/null 2>&1
+        walls+=$(( (EPOCHREALTIME - start) * 1000 ))
+        frames+=$(jq '.histograms.open_to_first_frame.sum_ms // 0' $scratch/metrics.json)
+    done
+    walls=(${(on)walls})
+    frames=(${(on)frames})
+    p50=$(( RUNS / 2 + 1 ))
+    p90=$(( (RUNS * 9 + 9) / 10 ))
+    printf "%-32s %10.1f %10.1f %14.1f %14.1f\n" ${build:t} $walls[$p50] $walls[$p90] $frames[$p50] $frames[$p90]
+done
@@ -0,0 +1,338 @@
+// Minimal Hyprland IPC client: request/response on .socket.sock, the event
+// stream on .socket2.sock, and just enough JSON to read the replies.
+// No GTK here so the same code can run headless.
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+class JsonValue {
+public:
+    enum Type { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT };
+
+    Type type = NUL;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> items;                           // ARRAY
+    std::vector<std::pair<std::string, JsonValue>> members; // OBJECT
+
+    // Missing keys and out-of-range indices yield a null value so lookups can be chained
+    const JsonValue& operator[](const char* key) const {
+        for (const auto& member : members) {
+            if (member.first == key) return member.second;
+        }
+        return null_value();
+    }
+
+    const JsonValue& operator[](size_t index) const {
+        return index < items.size() ? items[index] : null_value();
+    }
+
+    int as_int(int fallback = 0) const {
+        return type == NUMBER ? static_cast<int>(number) : fallback;
+    }
+
+    const std::string& as_string() const {
+        return string; // Empty unless type == STRING
+    }
+
+    static bool parse(const std::string& text, JsonValue& out);
+
+private:
+    static const JsonValue& null_value() {
+        static const JsonValue value;
+        return value;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : p(text.data()), end(text.data() + text.size()) {}
+
+    bool parse(JsonValue& out) {
+        skip_whitespace();
+        if (!parse_value(out, 0)) return false;
+        skip_whitespace();
+        return p == end;
+    }
+
+private:
+    static constexpr int max_depth = 64;
+
+    void skip_whitespace() {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+    }
+
+    bool consume(const char* literal) {
+        size_t len = std::strlen(literal);
+        if (static_cast<size_t>(end - p) < len || std::memcmp(p, literal, len) != 0) return false;
+        p += len;
+        return true;
+    }
+
+    bool parse_value(JsonValue& out, int depth) {
+        if (p >= end || depth > max_depth) return false;
+        switch (*p) {
+            case '{': return parse_object(out, depth);
+            case '[': return parse_array(out, depth);
+            case '"': out.type = JsonValue::STRING; return parse_string(out.string);
+            case 't': out.type = JsonValue::BOOL; out.boolean = true; return consume("true");
+            case 'f': out.type = JsonValue::BOOL; out.boolean = false; return consume("false");
+            case 'n': out.type = JsonValue::NUL; return consume("null");
+            default: return parse_number(out);
+        }
+    }
+
+    bool parse_object(JsonValue& out, int depth) {
+        out.type = JsonValue::OBJECT;
+        p++; // '{'
+        skip_whitespace();
+        if (p < end && *p == '}') { p++; return true; }
+        while (p < end) {
+            std::string key;
+            if (*p != '"' || !parse_string(key)) return false;
+            skip_whitespace();
+            if (p >= end || *p != ':') return false;
+            p++;
+            skip_whitespace();
+            out.members.emplace_back(std::move(key), JsonValue());
+            if (!parse_value(out.members.back().second, depth + 1)) return false;
+            skip_whitespace();
+            if (p < end && *p == ',') { p++; skip_whitespace(); continue; }
+            if (p < end && *p == '}') { p++; return true; }
+            return false;
+        }
+        return false;
+    }
+
+    bool parse_array(JsonValue& out, int depth) {
+        out.type = JsonValue::ARRAY;
+        p++; // '['
+        skip_whitespace();
+        if (p < end && *p == ']') { p++; return true; }
+        while (p < end) {
+            out.items.emplace_back();
+            if (!parse_value(out.items.back(), depth + 1)) return false;
+            skip_whitespace();
+            if (p < end && *p == ',') { p++; skip_whitespace(); continue; }
+            if (p < end && *p == ']') { p++; return true; }
+            return false;
+        }
+        return false;
+    }
+
+    bool parse_number(JsonValue& out) {
+        const char* start = p;
+        if (p < end && *p == '-') p++;
+        while (p < end && ((*p >= '0' && *p <= '9') || *p == '.' || *p == 'e' || *p == 'E' || *p == '+' || *p == '-')) p++;
+        if (p == start) return false;
+        out.type = JsonValue::NUMBER;
+        out.number = std::strtod(std::string(start, p).c_str(), nullptr);
+        return true;
+    }
+
+    static void append_utf8(std::string& out, uint32_t cp) {
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    bool parse_hex4(uint32_t& cp) {
+        if (end - p < 4) return false;
+        cp = 0;
+        for (int i = 0; i < 4; i++, p++) {
+            char c = *p;
+            cp <<= 4;
+            if (c >= '0' && c <= '9') cp |= c - '0';
+            else if (c >= 'a' && c <= 'f') cp |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') cp |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    bool parse_string(std::string& out) {
+        p++; // '"'
+        while (p < end) {
+            const char* run = p;
+            while (p < end && *p != '"' && *p != '\\') p++;
+            out.append(run, p);
+            if (p >= end) return false;
+            if (*p == '"') { p++; return true; }
+            p++; // '\\'
+            if (p >= end) return false;
+            char c = *p++;
+            switch (c) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t cp;
+                    if (!parse_hex4(cp)) return false;
+                    // Surrogate pair
+                    if (cp >= 0xD800 && cp <= 0xDBFF && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                        p += 2;
+                        uint32_t low;
+                        if (!parse_hex4(low)) return false;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    append_utf8(out, cp);
+                    break;
+                }
+                default: return false;
+            }
+        }
+        return false;
+    }
+
+    const char* p;
+    const char* end;
+};
+
+inline bool JsonValue::parse(const std::string& text, JsonValue& out) {
+    out = JsonValue();
+    return JsonParser(text).parse(out);
+}
+
+class HyprIPC {
+public:
+    // Directory holding this Hyprland instance's sockets, empty outside Hyprland
+    static std::string socket_dir() {
+        const char* signature = getenv("HYPRLAND_INSTANCE_SIGNATURE");
+        if (!signature || !*signature) {
+            return "";
+        }
+        const char* runtime_dir = getenv("XDG_RUNTIME_DIR");
+        if (runtime_dir && *runtime_dir) {
+            std::string dir = std::string(runtime_dir) + "/hypr/" + signature;
+            if (access((dir + "/.socket.sock").c_str(), F_OK) == 0) {
+                return dir;
+            }
+        }
+        return std::string("/tmp/hypr/") + signature; // Hyprland before 0.40
+    }
+
+    static int connect_socket(const std::string& path) {
+        sockaddr_un addr = {};
+        if (path.size() >= sizeof(addr.sun_path)) {
+            return -1;
+        }
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    // One round trip on .socket.sock: Hyprland answers and closes the connection
+    static bool request(const std::string& command, std::string& reply) {
+        reply.clear();
+        std::string dir = socket_dir();
+        if (dir.empty()) {
+            return false;
+        }
+        int fd = connect_socket(dir + "/.socket.sock");
+        if (fd < 0) {
+            return false;
+        }
+        size_t written = 0;
+        while (written < command.size()) {
+            ssize_t n = write(fd, command.data() + written, command.size() - written);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                close(fd);
+                return false;
+            }
+            written += static_cast<size_t>(n);
+        }
+        char buffer[8192];
+        while (true) {
+            ssize_t n = read(fd, buffer, sizeof(buffer));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            reply.append(buffer, static_cast<size_t>(n));
+        }
+        close(fd);
+        return !reply.empty();
+    }
+
+    // Dispatchers answer "ok" or an error message; how a [[BATCH]]'s answers are separated
+    // differs between versions ("okok", blank lines), so this fails only when something
+    // other than "ok" and whitespace comes back
+    static bool dispatch(const std::string& command, std::string& reply) {
+        if (!request(command, reply)) {
+            return false;
+        }
+        std::string rest = reply;
+        for (size_t ok = rest.find("ok"); ok != std::string::npos; ok = rest.find("ok", ok)) {
+            rest.erase(ok, 2);
+        }
+        return rest.find_first_not_of(" \t\r\n") == std::string::npos;
+    }
+
+    static bool request_json(const std::string& command, JsonValue& out) {
+        std::string reply;
+        return request("j/" + command, reply) && JsonValue::parse(reply, out);
+    }
+
+    // Connection to the .socket2.sock event stream, -1 outside Hyprland
+    static int open_event_stream() {
+        std::string dir = socket_dir();
+        return dir.empty() ? -1 : connect_socket(dir + "/.socket2.sock");
+    }
+
+    // Appends newly available "event>>data" lines; false once the stream is closed
+    static bool read_events(int fd, std::string& pending, std::vector<std::string>& events) {
+        char buffer[4096];
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n < 0 && (errno == EINTR || errno == EAGAIN)) {
+            return true;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        pending.append(buffer, static_cast<size_t>(n));
+        size_t start = 0;
+        size_t newline;
+        while ((newline = pending.find('\n', start)) != std::string::npos) {
+            if (newline > start) {
+                events.emplace_back(pending, start, newline - start);
+            }
+            start = newline + 1;
+        }
+        pending.erase(0, start);
+        return true;
+    }
+};
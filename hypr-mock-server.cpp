@@ -0,0 +1,615 @@
+// Stand-in for a Hyprland instance: serves the .socket.sock request/response
+// protocol and the .socket2.sock event stream from recorded fixtures, with
+// injected latency and synthetic client counts, so the switcher's IPC and model
+// code can be driven without a live session.
+//
+//   hypr-mock-server record <fixtures-dir> [event-seconds]
+//   hypr-mock-server serve  [<fixtures-dir>] [options]
+//   hypr-mock-server bench  [<fixtures-dir>] [options]
+//
+// record captures clients/workspaces/monitors/activeworkspace from the running
+// Hyprland into <name>.json and, for event-seconds, the event stream into
+// events.log ("<ms since start>\t<event>>data" per line). serve creates
+// $XDG_RUNTIME_DIR/hypr/<signature>/ and prints the signature to export as
+// HYPRLAND_INSTANCE_SIGNATURE. bench serves in-process and runs HyprIPC and
+// WorkspaceModel against it, printing metrics JSON on stdout.
+//
+// Options:
+//   --latency-ms=N    delay before every reply
+//   --jitter-ms=N     extra uniform random delay, 0..N
+//   --clients=N       synthetic clients instead of the clients/workspaces fixtures
+//   --workspaces=N    workspaces the synthetic clients are spread over (default 10)
+//   --event-rate=HZ   synthetic window events per second
+//   --speed=X         replay events.log X times faster (default 1)
+//   --loop            replay events.log forever
+//   --signature=NAME  instance signature to serve under (default mock-<pid>)
+//   --requests=N      bench: sequential model refreshes (default 200)
+//   --threads=N       bench: concurrent request_json("clients") callers (default 4)
+//   --seconds=N       bench: length of the event-driven phase (default 5)
+#include <poll.h>
+#include <sys/stat.h>
+#include <csignal>
+#include <pthread.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "hypr-ipc.hpp"
+#include "switcher-metrics.hpp"
+#include "workspace-model.hpp"
+
+struct MockOptions {
+    std::string fixtures_dir;
+    std::string signature;
+    int latency_ms = 0;
+    int jitter_ms = 0;
+    int synthetic_clients = -1; // -1: use the fixtures
+    int synthetic_workspaces = 10;
+    double event_rate = 0.0;
+    double speed = 1.0;
+    bool loop = false;
+    int requests = 200;
+    int threads = 4;
+    int seconds = 5;
+};
+
+static std::string read_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return "";
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+static bool write_file(const std::string& path, const std::string& content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+    return static_cast<bool>(file);
+}
+
+static std::string json_escape(const std::string& value) {
+    std::string out;
+    for (char c : value) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+class MockHyprland {
+public:
+    explicit MockHyprland(const MockOptions& options) : options(options), random(std::random_device{}()) {}
+
+    ~MockHyprland() {
+        stop();
+    }
+
+    // Listens under $XDG_RUNTIME_DIR/hypr/<signature>; false if the sockets cannot be created
+    bool start() {
+        load_fixtures();
+        const char* runtime_dir = getenv("XDG_RUNTIME_DIR");
+        dir = std::string(runtime_dir && *runtime_dir ? runtime_dir : "/tmp") + "/hypr";
+        mkdir(dir.c_str(), 0700);
+        dir += "/" + options.signature;
+        mkdir(dir.c_str(), 0700);
+        request_fd = listen_socket(dir + "/.socket.sock");
+        event_fd = listen_socket(dir + "/.socket2.sock");
+        if (request_fd < 0 || event_fd < 0 || pipe(wake_pipe) < 0) {
+            std::cerr << "Error creating sockets in " << dir << std::endl;
+            return false;
+        }
+        accept_thread = std::thread(&MockHyprland::accept_loop, this);
+        event_thread = std::thread(&MockHyprland::event_loop, this);
+        return true;
+    }
+
+    void stop() {
+        if (!accept_thread.joinable()) {
+            return;
+        }
+        stopping = true;
+        ssize_t n = write(wake_pipe[1], "x", 1);
+        (void)n;
+        event_wake.notify_all();
+        accept_thread.join();
+        event_thread.join();
+        // Request handlers sleep for the injected latency; let them finish before tearing down
+        std::unique_lock<std::mutex> lock(mutex);
+        handlers_done.wait(lock, [this] { return active_handlers == 0; });
+        for (int fd : subscribers) close(fd);
+        subscribers.clear();
+        close(request_fd);
+        close(event_fd);
+        close(wake_pipe[0]);
+        close(wake_pipe[1]);
+        unlink((dir + "/.socket.sock").c_str());
+        unlink((dir + "/.socket2.sock").c_str());
+        rmdir(dir.c_str());
+    }
+
+    uint64_t requests_served() const {
+        return served;
+    }
+
+    uint64_t events_sent() const {
+        return sent;
+    }
+
+    // Time of the oldest event sent since the last call, for event-to-publish latency
+    bool take_first_pending_event(std::chrono::steady_clock::time_point& when) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!has_pending_event) {
+            return false;
+        }
+        when = first_pending_event;
+        has_pending_event = false;
+        return true;
+    }
+
+private:
+    void load_fixtures() {
+        static const char* names[] = {"clients", "workspaces", "monitors", "activeworkspace", "activewindow",
+                                      "version"};
+        for (const char* name : names) {
+            std::string content = options.fixtures_dir.empty() ? "" : read_file(options.fixtures_dir + "/" + name + ".json");
+            if (!content.empty()) {
+                fixtures[name] = content;
+            }
+        }
+        if (fixtures.find("monitors") == fixtures.end()) {
+            fixtures["monitors"] = "[{\"id\":0,\"name\":\"MOCK-1\",\"x\":0,\"y\":0,\"width\":1920,\"height\":1080,"
+                                   "\"scale\":1.0,\"transform\":0,\"focused\":true}]";
+        }
+        if (options.synthetic_clients >= 0) {
+            synthesize_clients();
+        }
+        if (!options.fixtures_dir.empty()) {
+            load_event_log(options.fixtures_dir + "/events.log");
+        }
+    }
+
+    // Clients spread round-robin over the workspaces, tiled in a grid on monitor 0
+    void synthesize_clients() {
+        static const char* classes[] = {"firefox", "kitty", "code", "thunar", "discord", "spotify", "obs", "gimp"};
+        int workspace_count = std::max(1, options.synthetic_workspaces);
+        std::vector<int> per_workspace(workspace_count, 0);
+        std::ostringstream clients;
+        clients << "[";
+        for (int i = 0; i < options.synthetic_clients; i++) {
+            int workspace = i % workspace_count + 1;
+            int slot = per_workspace[workspace - 1]++;
+            const char* app = classes[i % (sizeof(classes) / sizeof(classes[0]))];
+            clients << (i ? "," : "") << "{\"address\":\"0x" << std::hex << (0x55550000 + i) << std::dec
+                    << "\",\"mapped\":true,\"hidden\":false,\"at\":[" << (slot % 4) * 480 << "," << (slot / 4 % 4) * 270
+                    << "],\"size\":[470,260],\"workspace\":{\"id\":" << workspace << ",\"name\":\"" << workspace
+                    << "\"},\"floating\":false,\"monitor\":0,\"class\":\"" << app << "\",\"title\":\""
+                    << json_escape(std::string(app) + " window " + std::to_string(i)) << "\",\"pid\":" << 1000 + i
+                    << "}";
+        }
+        clients << "]";
+        std::ostringstream workspaces;
+        workspaces << "[";
+        for (int w = 1; w <= workspace_count; w++) {
+            workspaces << (w > 1 ? "," : "") << "{\"id\":" << w << ",\"name\":\"" << w
+                       << "\",\"monitor\":\"MOCK-1\",\"monitorID\":0,\"windows\":" << per_workspace[w - 1] << "}";
+        }
+        workspaces << "]";
+        fixtures["clients"] = clients.str();
+        fixtures["workspaces"] = workspaces.str();
+        fixtures["activeworkspace"] = "{\"id\":1,\"name\":\"1\",\"monitorID\":0}";
+    }
+
+    void load_event_log(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            size_t tab = line.find('\t');
+            if (tab == std::string::npos || line.find(">>", tab) == std::string::npos) {
+                continue;
+            }
+            recorded_events.push_back({std::atol(line.c_str()), line.substr(tab + 1)});
+        }
+    }
+
+    static int listen_socket(const std::string& path) {
+        sockaddr_un addr = {};
+        if (path.size() >= sizeof(addr.sun_path)) {
+            return -1;
+        }
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+        unlink(path.c_str());
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(fd, 64) < 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    void accept_loop() {
+        pollfd fds[3] = {{request_fd, POLLIN, 0}, {event_fd, POLLIN, 0}, {wake_pipe[0], POLLIN, 0}};
+        while (!stopping) {
+            if (poll(fds, 3, -1) < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            if (fds[2].revents) {
+                break;
+            }
+            if (fds[0].revents) {
+                int client = accept4(request_fd, nullptr, nullptr, SOCK_CLOEXEC);
+                if (client >= 0) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    active_handlers++;
+                    std::thread(&MockHyprland::handle_request, this, client).detach();
+                }
+            }
+            if (fds[1].revents) {
+                int client = accept4(event_fd, nullptr, nullptr, SOCK_CLOEXEC);
+                if (client >= 0) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    subscribers.push_back(client);
+                    has_subscriber = true;
+                    event_wake.notify_all();
+                }
+            }
+        }
+    }
+
+    // One command per connection, answered and closed like Hyprland does
+    void handle_request(int client) {
+        char buffer[8192];
+        ssize_t n = read(client, buffer, sizeof(buffer));
+        std::string reply = n > 0 ? reply_for(std::string(buffer, static_cast<size_t>(n))) : "";
+        int delay = options.latency_ms;
+        if (options.jitter_ms > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            delay += std::uniform_int_distribution<int>(0, options.jitter_ms)(random);
+        }
+        if (delay > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+        }
+        size_t written = 0;
+        while (written < reply.size()) {
+            ssize_t w = send(client, reply.data() + written, reply.size() - written, MSG_NOSIGNAL);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) break;
+            written += static_cast<size_t>(w);
+        }
+        close(client);
+        served++;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--active_handlers == 0) {
+            handlers_done.notify_all();
+        }
+    }
+
+    std::string reply_for(std::string command) {
+        if (command.compare(0, 9, "[[BATCH]]") == 0) {
+            // One "ok" per dispatch, as Hyprland answers a batch
+            std::string reply;
+            size_t count = 1;
+            for (char c : command) count += c == ';';
+            for (size_t i = 0; i < count; i++) reply += i ? "\n\nok" : "ok";
+            return reply;
+        }
+        size_t slash = command.find('/');
+        if (slash != std::string::npos && slash < command.find(' ')) {
+            command.erase(0, slash + 1); // Output flags such as j/
+        }
+        std::string name = command.substr(0, command.find(' '));
+        if (name == "dispatch" || name == "keyword" || name == "reload") {
+            return "ok";
+        }
+        auto it = fixtures.find(name);
+        return it != fixtures.end() ? it->second : "unknown request";
+    }
+
+    void broadcast(const std::string& event) {
+        std::string line = event + "\n";
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < subscribers.size();) {
+            if (send(subscribers[i], line.data(), line.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(line.size())) {
+                close(subscribers[i]);
+                subscribers.erase(subscribers.begin() + static_cast<long>(i));
+                continue;
+            }
+            i++;
+        }
+        if (!has_pending_event) {
+            has_pending_event = true;
+            first_pending_event = std::chrono::steady_clock::now();
+        }
+        sent++;
+    }
+
+    // Sleeps until the deadline; false when stopping
+    bool wait_until(std::chrono::steady_clock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(event_mutex);
+        return !event_wake.wait_until(lock, deadline, [this] { return stopping.load(); });
+    }
+
+    void event_loop() {
+        if (!recorded_events.empty()) {
+            // Replay timing starts with the first listener, so nothing recorded is missed
+            std::unique_lock<std::mutex> lock(event_mutex);
+            event_wake.wait(lock, [this] { return stopping || has_subscriber; });
+        }
+        auto start = std::chrono::steady_clock::now();
+        size_t next_recorded = 0;
+        auto next_synthetic = start;
+        uint64_t synthetic_count = 0;
+        while (!stopping) {
+            if (next_recorded == recorded_events.size() && options.loop && !recorded_events.empty()) {
+                start = std::chrono::steady_clock::now();
+                next_recorded = 0;
+            }
+            bool recorded = next_recorded < recorded_events.size();
+            bool synthetic = options.event_rate > 0;
+            if (!recorded && !synthetic) {
+                std::unique_lock<std::mutex> lock(event_mutex);
+                event_wake.wait(lock, [this] { return stopping.load(); }); // Nothing left to send
+                break;
+            }
+            auto next_replay = recorded ? start + std::chrono::microseconds(static_cast<int64_t>(
+                                                      recorded_events[next_recorded].first * 1000 / options.speed))
+                                        : std::chrono::steady_clock::time_point::max();
+            bool replay = recorded && (!synthetic || next_replay <= next_synthetic);
+            if (!wait_until(replay ? next_replay : next_synthetic)) {
+                break;
+            }
+            if (replay) {
+                broadcast(recorded_events[next_recorded++].second);
+            } else {
+                broadcast(synthetic_event(synthetic_count++));
+                next_synthetic += std::chrono::microseconds(static_cast<int64_t>(1e6 / options.event_rate));
+            }
+        }
+    }
+
+    // Title changes over the existing clients, which every consumer treats as a model change
+    std::string synthetic_event(uint64_t n) const {
+        int clients = std::max(1, options.synthetic_clients);
+        std::ostringstream event;
+        event << "windowtitlev2>>" << std::hex << (0x55550000 + static_cast<int>(n % clients)) << std::dec
+              << ",title " << n;
+        return event.str();
+    }
+
+    MockOptions options;
+    std::map<std::string, std::string> fixtures;
+    std::vector<std::pair<long, std::string>> recorded_events; // ms offset, event line
+    std::string dir;
+    int request_fd = -1;
+    int event_fd = -1;
+    int wake_pipe[2] = {-1, -1};
+    std::thread accept_thread;
+    std::thread event_thread;
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> has_subscriber{false};
+    std::atomic<uint64_t> served{0};
+    std::atomic<uint64_t> sent{0};
+    std::mutex mutex; // subscribers, handler count, random, pending event time
+    std::condition_variable handlers_done;
+    int active_handlers = 0;
+    std::vector<int> subscribers;
+    std::mt19937 random;
+    bool has_pending_event = false;
+    std::chrono::steady_clock::time_point first_pending_event;
+    std::mutex event_mutex;
+    std::condition_variable event_wake;
+};
+
+// Captures the running Hyprland's replies (and optionally its events) as fixtures
+static int record_fixtures(const std::string& fixtures_dir, int event_seconds) {
+    if (HyprIPC::socket_dir().empty()) {
+        std::cerr << "Not running under Hyprland" << std::endl;
+        return 1;
+    }
+    mkdir(fixtures_dir.c_str(), 0755);
+    static const char* names[] = {"clients", "workspaces", "monitors", "activeworkspace", "activewindow", "version"};
+    for (const char* name : names) {
+        std::string reply;
+        if (!HyprIPC::request(std::string("j/") + name, reply) ||
+            !write_file(fixtures_dir + "/" + name + ".json", reply)) {
+            std::cerr << "Error recording " << name << std::endl;
+            return 1;
+        }
+    }
+    if (event_seconds <= 0) {
+        return 0;
+    }
+    int fd = HyprIPC::open_event_stream();
+    if (fd < 0) {
+        std::cerr << "Error opening the event stream" << std::endl;
+        return 1;
+    }
+    std::ofstream log(fixtures_dir + "/events.log", std::ios::trunc);
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::seconds(event_seconds);
+    std::string pending;
+    std::vector<std::string> events;
+    while (std::chrono::steady_clock::now() < end) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(end - std::chrono::steady_clock::now());
+        pollfd pfd = {fd, POLLIN, 0};
+        if (poll(&pfd, 1, static_cast<int>(left.count())) <= 0) {
+            continue;
+        }
+        events.clear();
+        if (!HyprIPC::read_events(fd, pending, events)) {
+            break;
+        }
+        long offset = static_cast<long>(Metrics::elapsed_ms(start));
+        for (const auto& event : events) {
+            log << offset << "\t" << event << "\n";
+        }
+    }
+    close(fd);
+    return 0;
+}
+
+static int serve(const MockOptions& options) {
+    // Blocked before the server threads start so only sigwait sees them
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    MockHyprland mock(options);
+    if (!mock.start()) {
+        return 1;
+    }
+    std::cout << options.signature << std::endl;
+    int signal_number = 0;
+    sigwait(&signals, &signal_number);
+    mock.stop();
+    std::cerr << "Served " << mock.requests_served() << " requests, " << mock.events_sent() << " events" << std::endl;
+    return 0;
+}
+
+// Drives the switcher's IPC and model code against an in-process server
+static int bench(MockOptions options) {
+    if (options.synthetic_clients < 0 && options.fixtures_dir.empty()) {
+        options.synthetic_clients = 100;
+    }
+    char runtime_template[] = "/tmp/hypr-mock-XXXXXX";
+    if (!mkdtemp(runtime_template)) {
+        return 1;
+    }
+    setenv("XDG_RUNTIME_DIR", runtime_template, 1);
+    setenv("HYPRLAND_INSTANCE_SIGNATURE", options.signature.c_str(), 1);
+    MockOptions server_options = options;
+    server_options.event_rate = 0; // Events only run in the last phase
+    Metrics metrics;
+    int failures = 0;
+    {
+        MockHyprland mock(server_options);
+        if (!mock.start()) {
+            return 1;
+        }
+        // Phase 1: sequential refreshes, the switcher's startup path
+        WorkspaceModel model(nullptr, &metrics);
+        for (int i = 0; i < options.requests; i++) {
+            Metrics::Timer timer(metrics, "bench.refresh");
+            if (!model.refresh()) failures++;
+            model.take();
+        }
+        // Phase 2: concurrent clients queries, for compositor-side throughput
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> callers;
+        std::atomic<int> call_failures{0};
+        for (int t = 0; t < options.threads; t++) {
+            callers.emplace_back([&] {
+                for (int i = 0; i < options.requests; i++) {
+                    JsonValue clients;
+                    auto call_start = std::chrono::steady_clock::now();
+                    if (!HyprIPC::request_json("clients", clients)) call_failures++;
+                    metrics.observe("bench.concurrent_rtt", Metrics::elapsed_ms(call_start));
+                }
+            });
+        }
+        for (auto& caller : callers) caller.join();
+        double elapsed = Metrics::elapsed_ms(start);
+        metrics.set("bench.concurrent_requests_per_s",
+                    static_cast<uint64_t>(options.threads * options.requests * 1000.0 / std::max(elapsed, 1e-3)));
+        failures += call_failures;
+        mock.stop();
+    }
+    if (options.event_rate > 0) {
+        // Phase 3: the model thread following an event stream, measuring event-to-publish latency
+        MockHyprland mock(options);
+        if (!mock.start()) {
+            return 1;
+        }
+        WorkspaceModel* model_ptr = nullptr;
+        WorkspaceModel model([&] {
+            std::chrono::steady_clock::time_point first;
+            if (mock.take_first_pending_event(first)) {
+                metrics.observe("bench.event_to_publish", Metrics::elapsed_ms(first));
+            }
+            if (model_ptr) model_ptr->take();
+        }, &metrics);
+        model_ptr = &model;
+        model.start();
+        std::this_thread::sleep_for(std::chrono::seconds(options.seconds));
+        model.stop();
+        mock.stop();
+        metrics.set("bench.events_sent", mock.events_sent());
+    }
+    metrics.set("bench.clients", static_cast<uint64_t>(std::max(0, options.synthetic_clients)));
+    metrics.set("bench.latency_ms", static_cast<uint64_t>(options.latency_ms));
+    metrics.set("bench.failures", static_cast<uint64_t>(failures));
+    metrics.write_json(std::cout);
+    std::cout << std::endl;
+    rmdir((std::string(runtime_template) + "/hypr").c_str());
+    rmdir(runtime_template);
+    return failures ? 1 : 0;
+}
+
+static bool parse_option(const std::string& arg, MockOptions& options) {
+    auto value = [&](const char* prefix, std::string& out) {
+        size_t length = std::strlen(prefix);
+        if (arg.compare(0, length, prefix) != 0) return false;
+        out = arg.substr(length);
+        return true;
+    };
+    std::string v;
+    if (value("--latency-ms=", v)) options.latency_ms = std::max(0, std::atoi(v.c_str()));
+    else if (value("--jitter-ms=", v)) options.jitter_ms = std::max(0, std::atoi(v.c_str()));
+    else if (value("--clients=", v)) options.synthetic_clients = std::max(0, std::atoi(v.c_str()));
+    else if (value("--workspaces=", v)) options.synthetic_workspaces = std::max(1, std::atoi(v.c_str()));
+    else if (value("--event-rate=", v)) options.event_rate = std::max(0.0, std::atof(v.c_str()));
+    else if (value("--speed=", v)) options.speed = std::max(0.01, std::atof(v.c_str()));
+    else if (value("--signature=", v)) options.signature = v;
+    else if (value("--requests=", v)) options.requests = std::max(1, std::atoi(v.c_str()));
+    else if (value("--threads=", v)) options.threads = std::max(1, std::atoi(v.c_str()));
+    else if (value("--seconds=", v)) options.seconds = std::max(1, std::atoi(v.c_str()));
+    else if (arg == "--loop") options.loop = true;
+    else return false;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string mode = argc > 1 ? argv[1] : "";
+    MockOptions options;
+    options.signature = "mock-" + std::to_string(getpid());
+    int first_option = 2;
+    if (argc > 2 && argv[2][0] != '-') {
+        options.fixtures_dir = argv[2];
+        first_option = 3;
+    }
+    if (mode == "record" && !options.fixtures_dir.empty()) {
+        return record_fixtures(options.fixtures_dir, argc > 3 ? std::atoi(argv[3]) : 0);
+    }
+    bool options_ok = true;
+    for (int i = first_option; i < argc; i++) {
+        if (!parse_option(argv[i], options)) {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            options_ok = false;
+        }
+    }
+    if (options_ok && mode == "serve" && (!options.fixtures_dir.empty() || options.synthetic_clients >= 0)) {
+        return serve(options);
+    }
+    if (options_ok && mode == "bench") {
+        return bench(options);
+    }
+    std::cerr << "Usage: " << argv[0] << " record <fixtures-dir> [event-seconds]\n"
+              << "       " << argv[0] << " serve [<fixtures-dir>] [options]\n"
+              << "       " << argv[0] << " bench [<fixtures-dir>] [options]" << std::endl;
+    return 2;
+}
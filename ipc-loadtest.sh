@@ -0,0 +1,48 @@
+#!/usr/bin/env zsh
+# Latency and throughput suite for the switcher's IPC and model code, run
+# against hypr-mock-server instead of a live Hyprland session.
+#
+#   ./ipc-loadtest.sh [fixtures-dir]
+#
+# CLIENTS, LATENCIES and EVENT_RATE override the matrix; a run fails when its
+# p90 refresh time exceeds REFRESH_BUDGET_MS plus the injected latency x3
+# (one round trip each for clients, workspaces and monitors).
+set -euo pipefail
+
+MOCK=${MOCK:-./hypr-mock-server}
+CLIENTS=(${=${CLIENTS:-10 100 500 1000}})
+LATENCIES=(${=${LATENCIES:-0 5 20}})
+EVENT_RATE=${EVENT_RATE:-120}
+REFRESH_BUDGET_MS=${REFRESH_BUDGET_MS:-50}
+FIXTURES=${1:-}
+
+if [[ ! -x "$MOCK" ]]; then
+    echo "[ipc-loadtest] $MOCK not found, build it with 'make mock'" >&2
+    exit 1
+fi
+
+failed=0
+printf "%8s %8s %12s %12s %12s %14s %10s\n" clients rtt_ms refresh_p50 refresh_p90 event_p90 concurrent/s snapshots
+for clients in $CLIENTS; do
+    for latency in $LATENCIES; do
+        args=(--clients=$clients --latency-ms=$latency --event-rate=$EVENT_RATE --seconds=3 --requests=100)
+        [[ -n "$FIXTURES" ]] && args=("$FIXTURES" $args)
+        if ! result=$("$MOCK" bench $args); then
+            echo "[ipc-loadtest] bench failed: clients=$clients latency=$latency" >&2
+            failed=1
+            continue
+        fi
+        echo "$result" | jq -r --argjson c $clients --argjson l $latency \
+            '[$c, $l, .histograms["bench.refresh"].p50_ms, .histograms["bench.refresh"].p90_ms,
+              (.histograms["bench.event_to_publish"].p90_ms // 0), .counters["bench.concurrent_requests_per_s"],
+              .counters.snapshots] | @tsv' |
+            while IFS=$'\t' read -r c l p50 p90 ev rps snaps; do
+                printf "%8s %8s %12.2f %12.2f %12.2f %14s %10s\n" $c $l $p50 $p90 $ev $rps $snaps
+                if (( p90 > REFRESH_BUDGET_MS + 3 * l )); then
+                    echo "[ipc-loadtest] refresh p90 ${p90}ms over budget: clients=$c latency=$l" >&2
+                    failed=1
+                fi
+            done
+    done
+done
+exit $failed
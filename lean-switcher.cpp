@@ -0,0 +1,684 @@
+// Lean switcher: the same ring of workspaces without GTK. Talks wayland-client
+// and wlr-layer-shell directly, draws with cairo into shm buffers and reads
+// keys through xkbcommon, so a cold start is a socket connect, one configure
+// and one cairo pass instead of gtk_init, CSS parsing and widget construction.
+//
+// Shows the 12 numbered workspaces and special:elysia in the center with the
+// theme's workspace icons (or, with --live-thumbnails, the preview pyramid's
+// button level); extra workspaces, search, tooltips and drag-and-drop stay in
+// the GTK build.
+//
+//   ely-workspace-switcher-lean [--live-thumbnails] [--metrics=PATH] [--exit-on-first-frame]
+#include <linux/input-event-codes.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cairo.h>
+#include <wayland-client.h>
+#include <wayland-cursor.h>
+#include <xkbcommon/xkbcommon.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "hypr-ipc.hpp"
+#include "preview-pyramid.hpp"
+#include "switcher-metrics.hpp"
+#include "theme-engine.hpp"
+#include "wlr-layer-shell-client.h"
+
+struct LeanOptions {
+    bool live_thumbnails = false;
+    bool exit_on_first_frame = false; // For startup benchmarks
+    std::string metrics_path;
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+};
+
+// One shm buffer; the compositor holds it until release
+struct ShmBuffer {
+    wl_buffer* buffer = nullptr;
+    void* data = nullptr;
+    size_t size = 0;
+    int width = 0;
+    int height = 0;
+    bool busy = false;
+};
+
+class LeanSwitcher {
+public:
+    static constexpr int numbered_workspace_count = 12;
+    static constexpr int special_slot = 13;
+
+    explicit LeanSwitcher(const LeanOptions& options) : options(options) {}
+
+    ~LeanSwitcher() {
+        for (cairo_surface_t* icon : icons) {
+            if (icon) cairo_surface_destroy(icon);
+        }
+        for (ShmBuffer& buffer : buffers) {
+            destroy_buffer(buffer);
+        }
+        if (xkb_state_) xkb_state_unref(xkb_state_);
+        if (keymap) xkb_keymap_unref(keymap);
+        if (xkb) xkb_context_unref(xkb);
+        if (cursor_theme) wl_cursor_theme_destroy(cursor_theme);
+        if (cursor_surface) wl_surface_destroy(cursor_surface);
+        if (layer_surface) zwlr_layer_surface_v1_destroy(layer_surface);
+        if (surface) wl_surface_destroy(surface);
+        if (display) wl_display_disconnect(display);
+    }
+
+    int run() {
+        display = wl_display_connect(nullptr);
+        if (!display) {
+            std::cerr << "Cannot connect to the Wayland display" << std::endl;
+            return 1;
+        }
+        wl_registry* registry = wl_display_get_registry(display);
+        wl_registry_add_listener(registry, &registry_listener(), this);
+        wl_display_roundtrip(display); // Globals
+        wl_display_roundtrip(display); // Output scales and seat capabilities
+        if (!compositor || !shm || !layer_shell) {
+            std::cerr << "Compositor lacks wl_compositor 4, wl_shm or zwlr_layer_shell_v1" << std::endl;
+            return 1;
+        }
+        ThemeEngine::Resolved theme = ThemeEngine::resolve(theme_file_path(), theme_selector_path(), theme_cache_path());
+        icon_dir = theme.icon_dir;
+        create_layer_surface();
+        while (running && wl_display_dispatch(display) != -1) {
+            // Icons are decoded after the first frame is up, then shown in one redraw
+            if (icons_pending) {
+                icons_pending = false;
+                load_icons();
+                redraw();
+            }
+        }
+        wl_display_roundtrip(display); // The last commit reaches the compositor before disconnecting
+        write_metrics();
+        return exit_code;
+    }
+
+private:
+    // --- Globals ---
+
+    static const wl_registry_listener& registry_listener() {
+        static wl_registry_listener listener = [] {
+            wl_registry_listener l = {};
+            l.global = [](void* data, wl_registry* registry, uint32_t name, const char* interface, uint32_t version) {
+                static_cast<LeanSwitcher*>(data)->on_global(registry, name, interface, version);
+            };
+            l.global_remove = [](void*, wl_registry*, uint32_t) {};
+            return l;
+        }();
+        return listener;
+    }
+
+    void on_global(wl_registry* registry, uint32_t name, const char* interface, uint32_t version) {
+        std::string id = interface;
+        // Never above what the compositor advertises; damage_buffer needs wl_compositor 4
+        if (id == wl_compositor_interface.name && version >= 4) {
+            compositor = static_cast<wl_compositor*>(
+                wl_registry_bind(registry, name, &wl_compositor_interface, std::min(version, 4u)));
+        } else if (id == wl_shm_interface.name) {
+            shm = static_cast<wl_shm*>(wl_registry_bind(registry, name, &wl_shm_interface, std::min(version, 1u)));
+        } else if (id == wl_seat_interface.name && !seat) {
+            seat = static_cast<wl_seat*>(wl_registry_bind(registry, name, &wl_seat_interface, std::min(version, 5u)));
+            wl_seat_add_listener(seat, &seat_listener(), this);
+        } else if (id == wl_output_interface.name && version >= 2) {
+            wl_output* output =
+                static_cast<wl_output*>(wl_registry_bind(registry, name, &wl_output_interface, std::min(version, 2u)));
+            wl_output_add_listener(output, &output_listener(), this);
+        } else if (id == zwlr_layer_shell_v1_interface.name) {
+            layer_shell = static_cast<zwlr_layer_shell_v1*>(
+                wl_registry_bind(registry, name, &zwlr_layer_shell_v1_interface, std::min(version, 3u)));
+        }
+    }
+
+    // Largest output scale; the overlay renders at it everywhere
+    static const wl_output_listener& output_listener() {
+        static wl_output_listener listener = [] {
+            wl_output_listener l = {};
+            l.geometry = [](void*, wl_output*, int32_t, int32_t, int32_t, int32_t, int32_t, const char*, const char*,
+                            int32_t) {};
+            l.mode = [](void*, wl_output*, uint32_t, int32_t, int32_t, int32_t) {};
+            l.done = [](void*, wl_output*) {};
+            l.scale = [](void* data, wl_output*, int32_t factor) {
+                LeanSwitcher* self = static_cast<LeanSwitcher*>(data);
+                self->scale = std::max(self->scale, static_cast<int>(factor));
+            };
+            return l;
+        }();
+        return listener;
+    }
+
+    static const wl_seat_listener& seat_listener() {
+        static wl_seat_listener listener = [] {
+            wl_seat_listener l = {};
+            l.capabilities = [](void* data, wl_seat* seat, uint32_t caps) {
+                static_cast<LeanSwitcher*>(data)->on_seat_capabilities(seat, caps);
+            };
+            l.name = [](void*, wl_seat*, const char*) {};
+            return l;
+        }();
+        return listener;
+    }
+
+    void on_seat_capabilities(wl_seat* seat, uint32_t caps) {
+        if ((caps & WL_SEAT_CAPABILITY_KEYBOARD) && !keyboard) {
+            keyboard = wl_seat_get_keyboard(seat);
+            wl_keyboard_add_listener(keyboard, &keyboard_listener(), this);
+        }
+        if ((caps & WL_SEAT_CAPABILITY_POINTER) && !pointer) {
+            pointer = wl_seat_get_pointer(seat);
+            wl_pointer_add_listener(pointer, &pointer_listener(), this);
+        }
+    }
+
+    // --- Surface ---
+
+    void create_layer_surface() {
+        surface = wl_compositor_create_surface(compositor);
+        layer_surface = zwlr_layer_shell_v1_get_layer_surface(layer_shell, surface, nullptr,
+                                                              ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY, "ely-workspace-switcher");
+        zwlr_layer_surface_v1_set_anchor(layer_surface,
+                                         ZWLR_LAYER_SURFACE_V1_ANCHOR_TOP | ZWLR_LAYER_SURFACE_V1_ANCHOR_BOTTOM |
+                                             ZWLR_LAYER_SURFACE_V1_ANCHOR_LEFT | ZWLR_LAYER_SURFACE_V1_ANCHOR_RIGHT);
+        zwlr_layer_surface_v1_set_size(layer_surface, 0, 0); // The compositor picks the output size
+        zwlr_layer_surface_v1_set_exclusive_zone(layer_surface, -1);
+        zwlr_layer_surface_v1_set_keyboard_interactivity(layer_surface, 1);
+        zwlr_layer_surface_v1_add_listener(layer_surface, &layer_surface_listener(), this);
+        wl_surface_commit(surface); // Empty commit asks for the first configure
+    }
+
+    static const zwlr_layer_surface_v1_listener& layer_surface_listener() {
+        static zwlr_layer_surface_v1_listener listener = [] {
+            zwlr_layer_surface_v1_listener l = {};
+            l.configure = [](void* data, zwlr_layer_surface_v1* layer_surface, uint32_t serial, uint32_t width,
+                             uint32_t height) {
+                LeanSwitcher* self = static_cast<LeanSwitcher*>(data);
+                zwlr_layer_surface_v1_ack_configure(layer_surface, serial);
+                self->on_configure(static_cast<int>(width), static_cast<int>(height));
+            };
+            l.closed = [](void* data, zwlr_layer_surface_v1*) {
+                static_cast<LeanSwitcher*>(data)->running = false;
+            };
+            return l;
+        }();
+        return listener;
+    }
+
+    // Same geometry as the GTK ring: sizes from the screen, 12 buttons on a circle
+    void on_configure(int configured_width, int configured_height) {
+        width = configured_width;
+        height = configured_height;
+        button_size = PreviewPyramid::button_size(width, height);
+        icon_size = PreviewPyramid::icon_size(button_size);
+        special_button_size = button_size * 2;
+        radius = std::max(200, static_cast<int>(std::min(width, height) * 0.40));
+        redraw();
+        if (first_frame) {
+            first_frame = false;
+            metrics.observe("open_to_first_frame", Metrics::elapsed_ms(options.started));
+            if (options.exit_on_first_frame) {
+                running = false;
+                return;
+            }
+            icons_pending = true;
+        }
+    }
+
+    void slot_center(int slot, double& x, double& y) const {
+        x = width / 2.0;
+        y = height / 2.0;
+        if (slot == special_slot) {
+            return;
+        }
+        double angle = (slot - 1) * (2 * M_PI / numbered_workspace_count) - (M_PI / 2);
+        x += radius * std::cos(angle);
+        y += radius * std::sin(angle);
+    }
+
+    int slot_at(double x, double y) const {
+        for (int slot = 1; slot <= special_slot; slot++) {
+            double cx, cy;
+            slot_center(slot, cx, cy);
+            double r = (slot == special_slot ? special_button_size : button_size) / 2.0;
+            if (std::hypot(x - cx, y - cy) <= r) {
+                return slot;
+            }
+        }
+        return 0;
+    }
+
+    // --- Rendering ---
+
+    ShmBuffer* acquire_buffer() {
+        int buffer_width = width * scale;
+        int buffer_height = height * scale;
+        for (ShmBuffer& buffer : buffers) {
+            if (buffer.busy) continue;
+            if (buffer.buffer && (buffer.width != buffer_width || buffer.height != buffer_height)) {
+                destroy_buffer(buffer);
+            }
+            if (!buffer.buffer && !create_buffer(buffer, buffer_width, buffer_height)) {
+                return nullptr;
+            }
+            return &buffer;
+        }
+        return nullptr; // Both in flight; the release handler redraws
+    }
+
+    bool create_buffer(ShmBuffer& buffer, int buffer_width, int buffer_height) {
+        int stride = cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, buffer_width);
+        size_t size = static_cast<size_t>(stride) * buffer_height;
+        int fd = memfd_create("ely-workspace-switcher", MFD_CLOEXEC);
+        if (fd < 0 || ftruncate(fd, static_cast<off_t>(size)) < 0) {
+            if (fd >= 0) close(fd);
+            return false;
+        }
+        void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        wl_shm_pool* pool = wl_shm_create_pool(shm, fd, static_cast<int32_t>(size));
+        buffer.buffer = wl_shm_pool_create_buffer(pool, 0, buffer_width, buffer_height, stride, WL_SHM_FORMAT_ARGB8888);
+        wl_shm_pool_destroy(pool);
+        close(fd);
+        buffer.data = data;
+        buffer.size = size;
+        buffer.width = buffer_width;
+        buffer.height = buffer_height;
+        wl_buffer_add_listener(buffer.buffer, &buffer_listener(), this);
+        return true;
+    }
+
+    static void destroy_buffer(ShmBuffer& buffer) {
+        if (buffer.buffer) wl_buffer_destroy(buffer.buffer);
+        if (buffer.data) munmap(buffer.data, buffer.size);
+        buffer = ShmBuffer();
+    }
+
+    static const wl_buffer_listener& buffer_listener() {
+        static wl_buffer_listener listener = [] {
+            wl_buffer_listener l = {};
+            l.release = [](void* data, wl_buffer* released) {
+                LeanSwitcher* self = static_cast<LeanSwitcher*>(data);
+                for (ShmBuffer& buffer : self->buffers) {
+                    if (buffer.buffer == released) buffer.busy = false;
+                }
+                if (self->redraw_pending) {
+                    self->redraw();
+                }
+            };
+            return l;
+        }();
+        return listener;
+    }
+
+    static const wl_callback_listener& frame_listener() {
+        static wl_callback_listener listener = [] {
+            wl_callback_listener l = {};
+            l.done = [](void* data, wl_callback* callback, uint32_t) {
+                LeanSwitcher* self = static_cast<LeanSwitcher*>(data);
+                wl_callback_destroy(callback);
+                self->frame_callback = nullptr;
+                if (self->redraw_pending) {
+                    self->redraw();
+                }
+            };
+            return l;
+        }();
+        return listener;
+    }
+
+    // Draws at most once per compositor frame; nothing animates, so an idle ring never wakes up
+    void redraw() {
+        redraw_pending = true;
+        if (frame_callback || width <= 0 || height <= 0) {
+            return;
+        }
+        ShmBuffer* buffer = acquire_buffer();
+        if (!buffer) {
+            return;
+        }
+        redraw_pending = false;
+        cairo_surface_t* target = cairo_image_surface_create_for_data(
+            static_cast<unsigned char*>(buffer->data), CAIRO_FORMAT_ARGB32, buffer->width, buffer->height,
+            cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, buffer->width));
+        cairo_t* cr = cairo_create(target);
+        cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+        cairo_set_source_rgba(cr, 0, 0, 0, 0);
+        cairo_paint(cr);
+        cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+        cairo_scale(cr, scale, scale);
+        for (int slot = 1; slot <= special_slot; slot++) {
+            draw_button(cr, slot);
+        }
+        cairo_destroy(cr);
+        cairo_surface_destroy(target);
+        wl_surface_set_buffer_scale(surface, scale);
+        wl_surface_attach(surface, buffer->buffer, 0, 0);
+        wl_surface_damage_buffer(surface, 0, 0, buffer->width, buffer->height);
+        frame_callback = wl_surface_frame(surface);
+        wl_callback_add_listener(frame_callback, &frame_listener(), this);
+        wl_surface_commit(surface);
+        buffer->busy = true;
+    }
+
+    void draw_button(cairo_t* cr, int slot) {
+        double cx, cy;
+        slot_center(slot, cx, cy);
+        double size = slot == special_slot ? special_button_size : button_size;
+        bool hovered = slot == hovered_slot;
+        cairo_save(cr);
+        cairo_translate(cr, cx, cy);
+        if (hovered) {
+            cairo_scale(cr, 1.1, 1.1);
+            draw_glow(cr, slot, size / 2.0);
+        }
+        cairo_surface_t* icon = icons[slot];
+        if (icon) {
+            // Pyramid levels are already at display size; theme icons are fitted to it
+            double target = slot == special_slot ? PreviewPyramid::center_icon_size(icon_size) : icon_size;
+            double icon_scale = target / std::max(cairo_image_surface_get_width(icon),
+                                                  cairo_image_surface_get_height(icon));
+            cairo_scale(cr, icon_scale, icon_scale);
+            cairo_set_source_surface(cr, icon, -cairo_image_surface_get_width(icon) / 2.0,
+                                     -cairo_image_surface_get_height(icon) / 2.0);
+            cairo_pattern_set_filter(cairo_get_source(cr), CAIRO_FILTER_GOOD);
+            cairo_paint(cr);
+        } else {
+            // Until icons load (or without one): the number, like the GTK button label
+            std::string label = slot == special_slot ? "13" : std::to_string(slot);
+            cairo_select_font_face(cr, "sans-serif", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
+            cairo_set_font_size(cr, size * 0.2);
+            cairo_text_extents_t extents;
+            cairo_text_extents(cr, label.c_str(), &extents);
+            cairo_move_to(cr, -extents.width / 2 - extents.x_bearing, -extents.height / 2 - extents.y_bearing);
+            cairo_set_source_rgb(cr, 1, 1, 1);
+            cairo_show_text(cr, label.c_str());
+        }
+        cairo_restore(cr);
+    }
+
+    // Static version of the GTK build's hover glow, in the theme's color for this workspace
+    void draw_glow(cairo_t* cr, int slot, double button_radius) {
+        if (!theme_loaded) {
+            theme_loaded = true; // Only hovering needs colors, so the theme file is read lazily
+            hover_theme = ThemeEngine::load(theme_file_path(), theme_selector_path());
+        }
+        double r = 1, g = 1, b = 1;
+        ThemeEngine::parse_rgb(hover_theme.colors[slot], r, g, b);
+        double glow = slot == special_slot ? hover_theme.center_glow_size : hover_theme.glow_size;
+        cairo_pattern_t* pattern = cairo_pattern_create_radial(0, 0, button_radius * 0.6, 0, 0, button_radius + glow * 3);
+        cairo_pattern_add_color_stop_rgba(pattern, 0.0, r, g, b, 0.0);
+        cairo_pattern_add_color_stop_rgba(pattern, 0.35, r, g, b, 0.5);
+        cairo_pattern_add_color_stop_rgba(pattern, 1.0, r, g, b, 0.0);
+        cairo_set_source(cr, pattern);
+        cairo_arc(cr, 0, 0, button_radius + glow * 3, 0, 2 * M_PI);
+        cairo_fill(cr);
+        cairo_pattern_destroy(pattern);
+    }
+
+    // PNG only: theme icons and pyramid levels are both written as PNG
+    void load_icons() {
+        Metrics::Timer timer(metrics, "decode_workspace_icons");
+        for (int slot = 1; slot <= special_slot; slot++) {
+            std::string path;
+            if (options.live_thumbnails) {
+                path = PreviewPyramid::level_path("/tmp/workspace_previews", slot,
+                                                  slot == special_slot ? PreviewPyramid::CENTER : PreviewPyramid::BUTTON,
+                                                  scale);
+            }
+            if (path.empty() || access(path.c_str(), R_OK) != 0) {
+                path = icon_dir + std::to_string(slot) + ".png";
+            }
+            cairo_surface_t* icon = cairo_image_surface_create_from_png(path.c_str());
+            if (cairo_surface_status(icon) == CAIRO_STATUS_SUCCESS) {
+                icons[slot] = icon;
+            } else {
+                cairo_surface_destroy(icon);
+            }
+        }
+    }
+
+    // --- Input ---
+
+    static const wl_pointer_listener& pointer_listener() {
+        static wl_pointer_listener listener = [] {
+            wl_pointer_listener l = {};
+            l.enter = [](void* data, wl_pointer* pointer, uint32_t serial, wl_surface*, wl_fixed_t x, wl_fixed_t y) {
+                LeanSwitcher* self = static_cast<LeanSwitcher*>(data);
+                self->set_cursor(pointer, serial);
+                self->on_pointer_motion(wl_fixed_to_double(x), wl_fixed_to_double(y));
+            };
+            l.leave = [](void* data, wl_pointer*, uint32_t, wl_surface*) {
+                static_cast<LeanSwitcher*>(data)->set_hovered(0);
+            };
+            l.motion = [](void* data, wl_pointer*, uint32_t, wl_fixed_t x, wl_fixed_t y) {
+                static_cast<LeanSwitcher*>(data)->on_pointer_motion(wl_fixed_to_double(x), wl_fixed_to_double(y));
+            };
+            l.button = [](void* data, wl_pointer*, uint32_t, uint32_t, uint32_t button, uint32_t state) {
+                LeanSwitcher* self = static_cast<LeanSwitcher*>(data);
+                if (button == BTN_LEFT && state == WL_POINTER_BUTTON_STATE_RELEASED && self->hovered_slot) {
+                    self->activate(self->hovered_slot);
+                }
+            };
+            l.axis = [](void*, wl_pointer*, uint32_t, uint32_t, wl_fixed_t) {};
+            l.frame = [](void*, wl_pointer*) {};
+            l.axis_source = [](void*, wl_pointer*, uint32_t) {};
+            l.axis_stop = [](void*, wl_pointer*, uint32_t, uint32_t) {};
+            l.axis_discrete = [](void*, wl_pointer*, uint32_t, int32_t) {};
+            return l;
+        }();
+        return listener;
+    }
+
+    // wayland-cursor is loaded on first pointer entry, so keyboard-only use never pays for it
+    void set_cursor(wl_pointer* pointer, uint32_t serial) {
+        if (!cursor_theme) {
+            cursor_theme = wl_cursor_theme_load(nullptr, 24 * scale, shm);
+            cursor_surface = wl_compositor_create_surface(compositor);
+        }
+        wl_cursor* cursor = cursor_theme ? wl_cursor_theme_get_cursor(cursor_theme, "left_ptr") : nullptr;
+        if (!cursor || cursor->image_count == 0) {
+            return;
+        }
+        wl_cursor_image* image = cursor->images[0];
+        wl_surface_set_buffer_scale(cursor_surface, scale);
+        wl_surface_attach(cursor_surface, wl_cursor_image_get_buffer(image), 0, 0);
+        wl_surface_damage_buffer(cursor_surface, 0, 0, static_cast<int32_t>(image->width),
+                                 static_cast<int32_t>(image->height));
+        wl_surface_commit(cursor_surface);
+        wl_pointer_set_cursor(pointer, serial, cursor_surface, static_cast<int32_t>(image->hotspot_x) / scale,
+                              static_cast<int32_t>(image->hotspot_y) / scale);
+    }
+
+    void on_pointer_motion(double x, double y) {
+        set_hovered(slot_at(x, y));
+    }
+
+    void set_hovered(int slot) {
+        if (slot != hovered_slot) {
+            hovered_slot = slot;
+            redraw();
+        }
+    }
+
+    static const wl_keyboard_listener& keyboard_listener() {
+        static wl_keyboard_listener listener = [] {
+            wl_keyboard_listener l = {};
+            l.keymap = [](void* data, wl_keyboard*, uint32_t format, int32_t fd, uint32_t size) {
+                static_cast<LeanSwitcher*>(data)->on_keymap(format, fd, size);
+            };
+            l.enter = [](void*, wl_keyboard*, uint32_t, wl_surface*, wl_array*) {};
+            l.leave = [](void*, wl_keyboard*, uint32_t, wl_surface*) {};
+            l.key = [](void* data, wl_keyboard*, uint32_t, uint32_t, uint32_t key, uint32_t state) {
+                if (state == WL_KEYBOARD_KEY_STATE_PRESSED) {
+                    static_cast<LeanSwitcher*>(data)->on_key(key);
+                }
+            };
+            l.modifiers = [](void* data, wl_keyboard*, uint32_t, uint32_t depressed, uint32_t latched,
+                             uint32_t locked, uint32_t group) {
+                LeanSwitcher* self = static_cast<LeanSwitcher*>(data);
+                if (self->xkb_state_) {
+                    xkb_state_update_mask(self->xkb_state_, depressed, latched, locked, 0, 0, group);
+                }
+            };
+            l.repeat_info = [](void*, wl_keyboard*, int32_t, int32_t) {};
+            return l;
+        }();
+        return listener;
+    }
+
+    void on_keymap(uint32_t format, int32_t fd, uint32_t size) {
+        if (format != WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1) {
+            close(fd);
+            return;
+        }
+        char* map = static_cast<char*>(mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+        close(fd);
+        if (map == MAP_FAILED) {
+            return;
+        }
+        if (!xkb) {
+            xkb = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+        }
+        xkb_keymap* new_keymap = xkb_keymap_new_from_string(xkb, map, XKB_KEYMAP_FORMAT_TEXT_V1,
+                                                            XKB_KEYMAP_COMPILE_NO_FLAGS);
+        munmap(map, size);
+        if (!new_keymap) {
+            return;
+        }
+        if (xkb_state_) xkb_state_unref(xkb_state_);
+        if (keymap) xkb_keymap_unref(keymap);
+        keymap = new_keymap;
+        xkb_state_ = xkb_state_new(keymap);
+    }
+
+    // Same bindings as the GTK build: 1-9, 0, -, = for the ring and Backspace for the center
+    void on_key(uint32_t key) {
+        if (!xkb_state_) {
+            return;
+        }
+        xkb_keysym_t sym = xkb_state_key_get_one_sym(xkb_state_, key + 8); // evdev to xkb keycode
+        int slot = 0;
+        if (sym >= XKB_KEY_1 && sym <= XKB_KEY_9) slot = static_cast<int>(sym - XKB_KEY_0);
+        else if (sym == XKB_KEY_0) slot = 10;
+        else if (sym == XKB_KEY_minus) slot = 11;
+        else if (sym == XKB_KEY_equal) slot = 12;
+        else if (sym == XKB_KEY_BackSpace) slot = special_slot;
+        else if (sym == XKB_KEY_Escape) running = false;
+        if (slot) {
+            activate(slot);
+        }
+    }
+
+    // One IPC round trip: leaving special:elysia and switching go out as a single batch
+    void activate(int slot) {
+        std::string command;
+        if (slot == special_slot) {
+            command = "dispatch togglespecialworkspace elysia";
+        } else {
+            JsonValue active;
+            bool on_special = HyprIPC::request_json("activewindow", active) && active["workspace"]["id"].as_int() < 0;
+            command = (on_special ? "[[BATCH]]dispatch togglespecialworkspace elysia;" : "") +
+                      std::string("dispatch workspace ") + std::to_string(slot);
+        }
+        std::string reply;
+        if (!HyprIPC::request(command, reply)) {
+            std::cerr << "Error switching to workspace " << slot << std::endl;
+            exit_code = 1;
+        }
+        running = false;
+    }
+
+    // --- Paths and metrics, shared with the GTK build ---
+
+    static std::string theme_file_path() {
+        return ThemeEngine::expand_home("~/.config/Elysia/workspace-themes.ini");
+    }
+
+    static std::string theme_selector_path() {
+        return ThemeEngine::expand_home("~/.config/hypr/Light.txt");
+    }
+
+    static std::string theme_cache_path() {
+        const char* cache_home = getenv("XDG_CACHE_HOME");
+        std::string dir = cache_home && *cache_home ? cache_home : ThemeEngine::expand_home("~/.cache");
+        return dir + "/ely-workspace-switcher/theme.css";
+    }
+
+    void write_metrics() {
+        if (options.metrics_path.empty()) {
+            return;
+        }
+        std::ofstream file(options.metrics_path, std::ios::trunc);
+        metrics.write_json(file);
+        file << std::endl;
+    }
+
+    LeanOptions options;
+    Metrics metrics;
+    bool running = true;
+    int exit_code = 0;
+    bool first_frame = true;
+    bool icons_pending = false;
+    bool redraw_pending = false;
+    bool theme_loaded = false;
+    Theme hover_theme;
+    std::string icon_dir;
+    cairo_surface_t* icons[special_slot + 1] = {};
+    int width = 0;
+    int height = 0;
+    int scale = 1;
+    int button_size = 120;
+    int icon_size = 100;
+    int special_button_size = 240;
+    int radius = 200;
+    int hovered_slot = 0;
+    wl_display* display = nullptr;
+    wl_compositor* compositor = nullptr;
+    wl_shm* shm = nullptr;
+    wl_seat* seat = nullptr;
+    wl_keyboard* keyboard = nullptr;
+    wl_pointer* pointer = nullptr;
+    zwlr_layer_shell_v1* layer_shell = nullptr;
+    wl_surface* surface = nullptr;
+    zwlr_layer_surface_v1* layer_surface = nullptr;
+    wl_callback* frame_callback = nullptr;
+    ShmBuffer buffers[2];
+    wl_cursor_theme* cursor_theme = nullptr;
+    wl_surface* cursor_surface = nullptr;
+    xkb_context* xkb = nullptr;
+    xkb_keymap* keymap = nullptr;
+    xkb_state* xkb_state_ = nullptr;
+};
+
+static LeanOptions parse_options(int argc, char* argv[]) {
+    LeanOptions options;
+    const char* runtime_dir = getenv("XDG_RUNTIME_DIR");
+    options.metrics_path = std::string(runtime_dir && *runtime_dir ? runtime_dir : "/tmp") +
+                           "/ely-workspace-switcher-lean-metrics.json";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--metrics=", 0) == 0) {
+            options.metrics_path = arg.substr(10);
+        } else if (arg == "--live-thumbnails") {
+            options.live_thumbnails = true;
+        } else if (arg == "--exit-on-first-frame") {
+            options.exit_on_first_frame = true;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+        }
+    }
+    return options;
+}
+
+int main(int argc, char* argv[]) {
+    LeanSwitcher switcher(parse_options(argc, argv));
+    return switcher.run();
+}
@@ -0,0 +1,57 @@
+// Power source detection for the low-power rendering mode: running on battery,
+// or the platform profile set to low-power (power-profiles-daemon and
+// tuned-ppd write their active profile there). Plain sysfs reads, no D-Bus.
+#pragma once
+
+#include <dirent.h>
+#include <fstream>
+#include <string>
+
+class PowerState {
+public:
+    static bool prefers_low_power() {
+        return low_power_profile() || on_battery();
+    }
+
+    static bool low_power_profile() {
+        return read_line("/sys/firmware/acpi/platform_profile") == "low-power";
+    }
+
+    // A supply that is online and not a battery (mains, USB-C) means plugged in;
+    // otherwise a discharging battery means running on it. Desktops have neither.
+    // Peripherals (wireless mice, keyboards) report scope=Device and are skipped.
+    static bool on_battery() {
+        const std::string root = "/sys/class/power_supply/";
+        DIR* dir = opendir(root.c_str());
+        if (!dir) {
+            return false;
+        }
+        bool external_power = false;
+        bool discharging = false;
+        while (dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] == '.') {
+                continue;
+            }
+            std::string supply = root + entry->d_name + "/";
+            if (read_line(supply + "scope") == "Device") {
+                continue;
+            }
+            std::string type = read_line(supply + "type");
+            if (type == "Battery") {
+                discharging |= read_line(supply + "status") == "Discharging";
+            } else if (read_line(supply + "online") == "1") {
+                external_power = true;
+            }
+        }
+        closedir(dir);
+        return discharging && !external_power;
+    }
+
+private:
+    static std::string read_line(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+};
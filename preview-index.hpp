@@ -0,0 +1,232 @@
+// Version index for the recorder's previews: a small shared file holding, per
+// workspace, the generation of its latest capture and when it was taken. The
+// recorder publishes into it after each capture; the switcher maps it read
+// only, so checking whether a cached thumbnail is current is a memory read
+// instead of a stat() per file.
+//
+// Layout: a header with the index-wide generation, then a fixed table of
+// entries. Each entry is a seqlock: the writer makes its sequence odd, updates
+// the fields and makes it even again; readers retry on an odd or changed
+// sequence, a bounded number of times. A writer killed mid-update leaves its
+// sequence odd; the next writer evens it out under the lock, and until then
+// readers give up on the index and probe files. Every publish takes the next
+// index-wide generation, so generations are unique and a single compare tells
+// a watcher whether anything changed.
+#pragma once
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+class PreviewIndex {
+public:
+    static constexpr uint32_t magic = 0x49505745; // "EWPI"
+    static constexpr uint32_t version = 1;
+    static constexpr int entry_count = 64;
+    static constexpr int max_read_retries = 1000; // An update is a handful of stores
+
+    struct Version {
+        uint64_t generation = 0; // 0 = never captured
+        int64_t content_time_ns = 0;
+    };
+
+    enum Lookup {
+        FOUND,
+        NOT_CAPTURED,
+        UNREADABLE // Closed, or an entry stayed mid-update; treat as no index
+    };
+
+    PreviewIndex() = default;
+    PreviewIndex(const PreviewIndex&) = delete;
+    PreviewIndex& operator=(const PreviewIndex&) = delete;
+
+    ~PreviewIndex() {
+        close();
+    }
+
+    // <dir>/index next to the captures
+    static std::string path(const std::string& dir) {
+        return dir + "/index";
+    }
+
+    // Readers fail on a missing or foreign file and keep probing files instead
+    bool open_read(const std::string& index_path) {
+        close();
+        fd = ::open(index_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size != static_cast<off_t>(sizeof(File)) || !map(PROT_READ)) {
+            close();
+            return false;
+        }
+        if (file->magic != magic || file->version != version) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    // Creates the index on first use; an existing one from another version is reset
+    bool open_write(const std::string& index_path) {
+        close();
+        fd = ::open(index_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        flock(fd, LOCK_EX); // One writer at a time; readers never lock
+        struct stat st;
+        bool fresh = fstat(fd, &st) != 0 || st.st_size != static_cast<off_t>(sizeof(File));
+        if ((fresh && ftruncate(fd, sizeof(File)) != 0) || !map(PROT_READ | PROT_WRITE)) {
+            close();
+            return false;
+        }
+        if (fresh || file->magic != magic || file->version != version) {
+            // Zero-filled by ftruncate or reset here; magic last so readers never see a half-made header
+            file->generation.store(0, std::memory_order_relaxed);
+            for (Entry& entry : file->entries) {
+                entry.workspace_id.store(0, std::memory_order_relaxed);
+                entry.generation.store(0, std::memory_order_relaxed);
+                entry.content_time_ns.store(0, std::memory_order_relaxed);
+            }
+            file->version = version;
+            std::atomic_thread_fence(std::memory_order_release);
+            file->magic = magic;
+        }
+        for (Entry& entry : file->entries) {
+            even_out(entry); // Left odd by a writer that died mid-update
+        }
+        return true;
+    }
+
+    bool is_open() const {
+        return file != nullptr;
+    }
+
+    // Bumped by every publish
+    uint64_t generation() const {
+        return file ? file->generation.load(std::memory_order_acquire) : 0;
+    }
+
+    // Fills out with the workspace's latest capture when FOUND
+    Lookup lookup(int workspace_id, Version& out) const {
+        if (!file) {
+            return UNREADABLE;
+        }
+        if (workspace_id == 0) {
+            return NOT_CAPTURED;
+        }
+        for (const Entry& entry : file->entries) {
+            int retries = 0;
+            while (true) {
+                uint32_t before = entry.sequence.load(std::memory_order_acquire);
+                int64_t id = entry.workspace_id.load(std::memory_order_relaxed);
+                Version read;
+                read.generation = entry.generation.load(std::memory_order_relaxed);
+                read.content_time_ns = entry.content_time_ns.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if ((before & 1) || entry.sequence.load(std::memory_order_relaxed) != before) {
+                    if (++retries == max_read_retries) {
+                        return UNREADABLE;
+                    }
+                    continue; // Mid-update
+                }
+                if (id == 0) {
+                    return NOT_CAPTURED; // Entries fill in order, so the rest are empty
+                }
+                if (id == workspace_id) {
+                    out = read;
+                    return FOUND;
+                }
+                break;
+            }
+        }
+        return NOT_CAPTURED;
+    }
+
+    // Writer side; returns the new generation, or 0 when the table is full. The file's
+    // ctime is touched afterwards so an inotify watcher (IN_ATTRIB) wakes up.
+    uint64_t publish(int workspace_id, int64_t content_time_ns) {
+        if (!file || workspace_id == 0) {
+            return 0;
+        }
+        Entry* target = nullptr;
+        for (Entry& entry : file->entries) {
+            int64_t id = entry.workspace_id.load(std::memory_order_relaxed);
+            if (id == workspace_id || id == 0) {
+                target = &entry;
+                break;
+            }
+        }
+        if (!target) {
+            return 0;
+        }
+        uint64_t generation = file->generation.load(std::memory_order_relaxed) + 1;
+        uint32_t sequence = even_out(*target);
+        target->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        target->workspace_id.store(workspace_id, std::memory_order_relaxed);
+        target->generation.store(generation, std::memory_order_relaxed);
+        target->content_time_ns.store(content_time_ns, std::memory_order_relaxed);
+        target->sequence.store(sequence + 2, std::memory_order_release);
+        file->generation.store(generation, std::memory_order_release);
+        fchmod(fd, 0644);
+        return generation;
+    }
+
+    void close() {
+        if (file) {
+            munmap(file, sizeof(File));
+            file = nullptr;
+        }
+        if (fd >= 0) {
+            ::close(fd); // Also drops the writer's lock
+            fd = -1;
+        }
+    }
+
+private:
+    struct Entry {
+        std::atomic<uint32_t> sequence;
+        uint32_t reserved;
+        std::atomic<int64_t> workspace_id; // 0 = unused; special workspaces are negative
+        std::atomic<uint64_t> generation;
+        std::atomic<int64_t> content_time_ns;
+    };
+
+    struct File {
+        uint32_t magic;
+        uint32_t version;
+        std::atomic<uint64_t> generation;
+        Entry entries[entry_count];
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "the index is shared between processes");
+
+    // Writer side, under the lock: no update is in flight, so an odd sequence is stale
+    static uint32_t even_out(Entry& entry) {
+        uint32_t sequence = entry.sequence.load(std::memory_order_relaxed);
+        if (sequence & 1) {
+            entry.sequence.store(++sequence, std::memory_order_release);
+        }
+        return sequence;
+    }
+
+    bool map(int protection) {
+        void* data = mmap(nullptr, sizeof(File), protection, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            return false;
+        }
+        file = static_cast<File*>(data);
+        return true;
+    }
+
+    int fd = -1;
+    File* file = nullptr;
+};
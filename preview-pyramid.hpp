@@ -0,0 +1,72 @@
+// Preview pyramid: every capture is stored once per size the switcher shows it
+// at, so previews load at their native size with no rescaling at runtime. The
+// recorder's helper and the switcher both size levels from the same metrics.
+#pragma once
+
+#include <algorithm>
+#include <string>
+
+class PreviewPyramid {
+public:
+    enum Level { TOOLTIP, BUTTON, CENTER, LEVEL_COUNT };
+
+    static const char* level_name(Level level) {
+        static const char* names[LEVEL_COUNT] = {"tooltip", "button", "center"};
+        return names[level];
+    }
+
+    // Ring metrics for a screen of the given logical size
+    static int button_size(int screen_width, int screen_height) {
+        return std::max(120, static_cast<int>(std::min(screen_width, screen_height) * 0.08));
+    }
+
+    static int icon_size(int button_size) {
+        return std::max(50, static_cast<int>(button_size * 0.83));
+    }
+
+    static int center_icon_size(int icon_size) {
+        return static_cast<int>(icon_size * 1.8);
+    }
+
+    static int thumbnail_width(int screen_width) {
+        return std::max(200, screen_width / 6);
+    }
+
+    static int thumbnail_height(int screen_width) {
+        return std::max(112, static_cast<int>(thumbnail_width(screen_width) * 9.0 / 16.0)); // 16:9 aspect ratio
+    }
+
+    // Logical box a level is shown in; images are fitted inside it keeping their aspect
+    static void level_box(Level level, int screen_width, int screen_height, int& width, int& height) {
+        int icon = icon_size(button_size(screen_width, screen_height));
+        switch (level) {
+            case TOOLTIP:
+                width = thumbnail_width(screen_width);
+                height = thumbnail_height(screen_width);
+                break;
+            case BUTTON:
+                width = height = icon;
+                break;
+            default:
+                width = height = center_icon_size(icon);
+                break;
+        }
+    }
+
+    // Size of a source_width x source_height image fitted inside a box
+    static void fit(int source_width, int source_height, int box_width, int box_height, int& width, int& height) {
+        if (static_cast<long>(source_width) * box_height > static_cast<long>(source_height) * box_width) {
+            width = box_width;
+            height = std::max(1, static_cast<int>(static_cast<long>(source_height) * box_width / source_width));
+        } else {
+            height = box_height;
+            width = std::max(1, static_cast<int>(static_cast<long>(source_width) * box_height / source_height));
+        }
+    }
+
+    // <dir>/workspace_<number>.<level>@<scale>x.png next to the full capture
+    static std::string level_path(const std::string& dir, int workspace_number, Level level, int scale) {
+        return dir + "/workspace_" + std::to_string(workspace_number) + "." + level_name(level) + "@" +
+               std::to_string(scale) + "x.png";
+    }
+};
@@ -0,0 +1,136 @@
+// Runtime metrics: named counters and latency histograms any thread can record
+// into, rendered as JSON for the control socket and the dump written on exit.
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+
+class Metrics {
+public:
+    void count(const std::string& name, uint64_t n = 1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        counters[name] += n;
+    }
+
+    // Replaces a counter's value, for numbers another component already keeps
+    void set(const std::string& name, uint64_t value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        counters[name] = value;
+    }
+
+    void observe(const std::string& name, double ms) {
+        std::lock_guard<std::mutex> lock(mutex);
+        histograms[name].add(ms);
+    }
+
+    // Records the time since start into a histogram when it goes out of scope
+    class Timer {
+    public:
+        Timer(Metrics& metrics, std::string name)
+            : metrics(metrics), name(std::move(name)), start(std::chrono::steady_clock::now()) {}
+        ~Timer() {
+            metrics.observe(name, elapsed_ms(start));
+        }
+
+    private:
+        Metrics& metrics;
+        std::string name;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void write_json(std::ostream& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        out << "{\"counters\":{";
+        const char* separator = "";
+        for (const auto& counter : counters) {
+            out << separator << "\"" << counter.first << "\":" << counter.second;
+            separator = ",";
+        }
+        out << "},\"histograms\":{";
+        separator = "";
+        for (const auto& entry : histograms) {
+            const Histogram& h = entry.second;
+            out << separator << "\"" << entry.first << "\":{\"count\":" << h.count << ",\"sum_ms\":" << h.sum
+                << ",\"min_ms\":" << (h.count ? h.min : 0.0) << ",\"max_ms\":" << h.max
+                << ",\"p50_ms\":" << h.quantile(0.50) << ",\"p90_ms\":" << h.quantile(0.90)
+                << ",\"p99_ms\":" << h.quantile(0.99) << "}";
+            separator = ",";
+        }
+        out << "}}";
+    }
+
+private:
+    // Log-linear buckets: each power of two from 1/64 ms up to ~17 min is split into
+    // 16 equal sub-buckets, so a bucket is at most 1/16 of its value wide. Quantiles
+    // interpolate inside the bucket and are clamped to the observed min and max.
+    struct Histogram {
+        static constexpr int octave_count = 26;
+        static constexpr int sub_bucket_count = 16;
+        static constexpr int bucket_count = octave_count * sub_bucket_count;
+        static constexpr double first_bound_ms = 1.0 / 64;
+
+        uint64_t buckets[bucket_count] = {};
+        uint64_t count = 0;
+        double sum = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+
+        void add(double ms) {
+            ms = std::max(0.0, ms);
+            int octave = 0;
+            double lower = 0.0;
+            double upper = first_bound_ms;
+            while (octave < octave_count - 1 && ms >= upper) {
+                lower = upper;
+                upper *= 2;
+                octave++;
+            }
+            int sub = static_cast<int>((ms - lower) / (upper - lower) * sub_bucket_count);
+            buckets[octave * sub_bucket_count + std::min(sub, sub_bucket_count - 1)]++;
+            min = count ? std::min(min, ms) : ms;
+            max = std::max(max, ms);
+            sum += ms;
+            count++;
+        }
+
+        double quantile(double q) const {
+            if (count == 0) {
+                return 0.0;
+            }
+            uint64_t rank = static_cast<uint64_t>(q * (count - 1)) + 1;
+            uint64_t seen = 0;
+            double lower = 0.0;
+            double upper = first_bound_ms;
+            for (int octave = 0; octave < octave_count; octave++) {
+                double width = (upper - lower) / sub_bucket_count;
+                for (int sub = 0; sub < sub_bucket_count; sub++) {
+                    uint64_t in_bucket = buckets[octave * sub_bucket_count + sub];
+                    if (seen + in_bucket >= rank) {
+                        // Observations are taken as spread evenly across the bucket
+                        double fraction = (rank - seen - 0.5) / in_bucket;
+                        double value = lower + width * (sub + fraction);
+                        return std::min(std::max(value, min), max);
+                    }
+                    seen += in_bucket;
+                }
+                lower = upper;
+                upper *= 2;
+            }
+            return max;
+        }
+    };
+
+    std::mutex mutex;
+    std::map<std::string, uint64_t> counters;
+    std::map<std::string, Histogram> histograms;
+};
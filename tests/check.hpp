@@ -0,0 +1,55 @@
+// Minimal checks for the header tests: a failed CHECK prints where it failed
+// and the test exits non-zero at the end. No framework, no GTK.
+#pragma once
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+static int check_failures = 0;
+
+#define CHECK(condition)                                                                                \
+    do {                                                                                                \
+        if (!(condition)) {                                                                             \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" << std::endl; \
+            check_failures++;                                                                           \
+        }                                                                                               \
+    } while (0)
+
+// Fresh directory under $TMPDIR for tests that write files, removed afterwards
+class ScratchDir {
+public:
+    ScratchDir() {
+        const char* tmp = getenv("TMPDIR");
+        std::string pattern = std::string(tmp && *tmp ? tmp : "/tmp") + "/ely-test-XXXXXX";
+        if (mkdtemp(&pattern[0])) {
+            dir = pattern;
+        }
+    }
+
+    ~ScratchDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    const std::string& directory() const {
+        return dir;
+    }
+
+    std::string path(const std::string& name) const {
+        return dir + "/" + name;
+    }
+
+private:
+    std::string dir;
+};
+
+static int check_result(const char* test) {
+    if (check_failures) {
+        std::cerr << test << ": " << check_failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << test << ": ok" << std::endl;
+    return 0;
+}
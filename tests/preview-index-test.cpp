@@ -0,0 +1,98 @@
+// Preview index: publish and lookup across two mappings of the same file, and
+// recovery from an entry left mid-update by a writer that was killed.
+#include "check.hpp"
+#include "preview-index.hpp"
+
+// Entry 0's sequence: after the header's magic, version and generation
+static constexpr off_t first_sequence_offset = 16;
+
+static void make_sequence_odd(const std::string& path) {
+    int fd = open(path.c_str(), O_RDWR);
+    uint32_t sequence = 0;
+    CHECK(pread(fd, &sequence, sizeof(sequence), first_sequence_offset) == sizeof(sequence));
+    sequence |= 1;
+    CHECK(pwrite(fd, &sequence, sizeof(sequence), first_sequence_offset) == sizeof(sequence));
+    close(fd);
+}
+
+static void test_publish_lookup(const ScratchDir& scratch) {
+    std::string path = PreviewIndex::path(scratch.directory());
+    PreviewIndex reader;
+    PreviewIndex::Version version;
+    CHECK(!reader.open_read(path)); // Not created yet
+    CHECK(reader.lookup(3, version) == PreviewIndex::UNREADABLE);
+
+    PreviewIndex writer;
+    CHECK(writer.open_write(path));
+    CHECK(writer.publish(3, 100) == 1);
+    CHECK(writer.publish(-98, 200) == 2); // Special workspaces are negative
+    CHECK(writer.publish(3, 300) == 3);
+    CHECK(writer.publish(0, 400) == 0);
+
+    CHECK(reader.open_read(path));
+    CHECK(reader.generation() == 3);
+    CHECK(reader.lookup(3, version) == PreviewIndex::FOUND);
+    CHECK(version.generation == 3 && version.content_time_ns == 300);
+    CHECK(reader.lookup(-98, version) == PreviewIndex::FOUND && version.generation == 2);
+    CHECK(reader.lookup(5, version) == PreviewIndex::NOT_CAPTURED);
+
+    // A live writer's updates show through the reader's mapping
+    CHECK(writer.publish(5, 500) == 4);
+    CHECK(reader.generation() == 4);
+    CHECK(reader.lookup(5, version) == PreviewIndex::FOUND && version.content_time_ns == 500);
+}
+
+static void test_full_table(const ScratchDir& scratch) {
+    PreviewIndex writer;
+    CHECK(writer.open_write(PreviewIndex::path(scratch.directory())));
+    for (int id = 1000; id < 1000 + PreviewIndex::entry_count; id++) {
+        writer.publish(id, id);
+    }
+    CHECK(writer.publish(1000 + PreviewIndex::entry_count, 0) == 0); // Full, but existing ids still update
+    CHECK(writer.publish(1000, 0) != 0);
+}
+
+static void test_killed_writer(const ScratchDir& scratch) {
+    std::string path = PreviewIndex::path(scratch.directory());
+    {
+        PreviewIndex writer;
+        CHECK(writer.open_write(path));
+        CHECK(writer.publish(3, 100) != 0);
+    }
+    make_sequence_odd(path);
+    PreviewIndex reader;
+    PreviewIndex::Version version;
+    CHECK(reader.open_read(path));
+    CHECK(reader.lookup(3, version) == PreviewIndex::UNREADABLE); // Gives up instead of spinning
+
+    // The next writer evens the sequence out on open
+    {
+        PreviewIndex writer;
+        CHECK(writer.open_write(path));
+    }
+    CHECK(reader.lookup(3, version) == PreviewIndex::FOUND && version.content_time_ns == 100);
+
+    // ... and so does a publish into the stuck entry
+    PreviewIndex writer;
+    CHECK(writer.open_write(path));
+    make_sequence_odd(path);
+    uint64_t generation = writer.publish(3, 700);
+    CHECK(reader.lookup(3, version) == PreviewIndex::FOUND);
+    CHECK(version.generation == generation && version.content_time_ns == 700);
+}
+
+int main() {
+    {
+        ScratchDir scratch;
+        test_publish_lookup(scratch);
+    }
+    {
+        ScratchDir scratch;
+        test_full_table(scratch);
+    }
+    {
+        ScratchDir scratch;
+        test_killed_writer(scratch);
+    }
+    return check_result("preview-index");
+}
@@ -0,0 +1,75 @@
+// Theme engine: INI parsing (defaults, comments, unknown keys), theme
+// priority when the selector names several, and the CSS cache stamp.
+#include "check.hpp"
+#include "theme-engine.hpp"
+
+static void test_parse() {
+    std::vector<Theme> themes = ThemeEngine::parse(
+        "; leading comment\n"
+        "ignored=before any section\n"
+        "[ely]\n"
+        "icon-dir = ~/icons/   ; trailing comment\n"
+        "glow-size=25\n"
+        "color-3=1,2,3\n"
+        "color-99=4,5,6\n"
+        "future-key=whatever\n"
+        "\n"
+        "[  night  ]\r\n"
+        "match=dark\n"
+        "inset-color-extra=7,8,9\n"
+        "pulse-seconds=2.5\n");
+    CHECK(themes.size() == 2);
+    if (themes.size() != 2) {
+        return;
+    }
+    CHECK(themes[0].name == "ely" && themes[0].match == "ely");
+    CHECK(themes[0].icon_dir == "~/icons/");
+    CHECK(themes[0].glow_size == 25);
+    CHECK(themes[0].colors[3] == "1,2,3");
+    CHECK(themes[0].colors[1] == "173,216,230"); // Unset keys keep the built-in values
+    CHECK(themes[1].name == "night" && themes[1].match == "dark");
+    CHECK(themes[1].inset_colors[14] == "7,8,9");
+    CHECK(themes[1].pulse_seconds == 2.5);
+    CHECK(themes[1].glow_size == 20);
+    CHECK(ThemeEngine::parse("").empty());
+
+    double r, g, b;
+    CHECK(ThemeEngine::parse_rgb("255, 0,51", r, g, b) && r == 1.0 && g == 0.0 && b == 0.2);
+    CHECK(!ThemeEngine::parse_rgb("red", r, g, b));
+}
+
+static void test_select() {
+    std::vector<Theme> themes = ThemeEngine::builtin_themes();
+    CHECK(ThemeEngine::select(themes, "elysia").name == "ely");
+    CHECK(ThemeEngine::select(themes, "cyrene").name == "cyrene");
+    CHECK(ThemeEngine::select(themes, "elysia cyrene").name == "cyrene"); // The longer match wins
+    CHECK(ThemeEngine::select(themes, "cyrene\nelysia").name == "cyrene");
+    CHECK(ThemeEngine::select(themes, "").name == "ely"); // No match: the first theme
+    std::vector<Theme> tied = ThemeEngine::parse("[one]\nmatch=abc\n[two]\nmatch=abc\n");
+    CHECK(ThemeEngine::select(tied, "abc").name == "one");
+}
+
+static void test_resolve(const ScratchDir& scratch) {
+    std::string themes_path = scratch.path("themes.ini");
+    std::string selector_path = scratch.path("Light.txt");
+    std::string cache_path = scratch.path("cache/theme.css");
+    std::ofstream(themes_path) << "[ely]\nicon-dir=/icons/ely\n[cyrene]\nicon-dir=/icons/amph/\n";
+    std::ofstream(selector_path) << "elysia cyrene\n";
+    ThemeEngine::Resolved first = ThemeEngine::resolve(themes_path, selector_path, cache_path);
+    CHECK(first.name == "cyrene" && first.icon_dir == "/icons/amph/");
+    CHECK(first.css.find(".workspace-13:hover") != std::string::npos);
+    ThemeEngine::Resolved cached = ThemeEngine::resolve(themes_path, selector_path, cache_path);
+    CHECK(cached.name == first.name && cached.icon_dir == first.icon_dir && cached.css == first.css);
+
+    std::ofstream(selector_path) << "elysia, a longer file so the stamp changes\n";
+    ThemeEngine::Resolved changed = ThemeEngine::resolve(themes_path, selector_path, cache_path);
+    CHECK(changed.name == "ely" && changed.icon_dir == "/icons/ely/"); // Trailing slash added
+}
+
+int main() {
+    ScratchDir scratch;
+    test_parse();
+    test_select();
+    test_resolve(scratch);
+    return check_result("theme-engine");
+}
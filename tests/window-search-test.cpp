@@ -0,0 +1,73 @@
+// Window search: trigram and scan answers agree, narrowing a query keeps the
+// same answers as a fresh one, and ranking puts the best matches first.
+#include "check.hpp"
+#include "window-search.hpp"
+
+static std::unique_ptr<WorkspaceSnapshot> make_snapshot(const std::string& clients, int active_workspace) {
+    JsonValue client_list, workspace_list, monitor_list;
+    JsonValue::parse(clients, client_list);
+    JsonValue::parse("[]", workspace_list);
+    JsonValue::parse("[{\"id\":0,\"focused\":true,\"activeWorkspace\":{\"id\":" + std::to_string(active_workspace) +
+                         "},\"width\":1920,\"height\":1080,\"scale\":1}]",
+                     monitor_list);
+    return WorkspaceSnapshot::from_ipc(client_list, workspace_list, monitor_list, 1);
+}
+
+static std::string client(const std::string& address, const std::string& app_class, const std::string& title,
+                          int workspace) {
+    return "{\"address\":\"" + address + "\",\"class\":\"" + app_class + "\",\"title\":\"" + title +
+           "\",\"workspace\":{\"id\":" + std::to_string(workspace) + ",\"name\":\"" + std::to_string(workspace) +
+           "\"},\"at\":[0,0],\"size\":[100,100],\"monitor\":0}";
+}
+
+static void test_query() {
+    std::string clients = "[";
+    for (int i = 0; i < 300; i++) {
+        const char* app_class = i % 3 == 0 ? "Firefox" : i % 3 == 1 ? "kitty" : "code-oss";
+        std::string title = "Window number " + std::to_string(i) + (i == 217 ? " Special Needle" : "");
+        clients += (i ? "," : "") + client("0x" + std::to_string(1000 + i), app_class, title, i % 20 + 1);
+    }
+    auto snapshot = make_snapshot(clients + "]", 1);
+    WindowSearch search;
+    search.build(*snapshot);
+    CHECK(search.is_built_for(snapshot->version));
+    CHECK(search.query("firefox").size() == 100);
+    CHECK(search.query("KIT").size() == 100);
+    CHECK(search.query("zzz").empty());
+    CHECK(search.query("").empty());
+    const std::vector<uint32_t>& needle = search.query("NEEDLE");
+    CHECK(needle.size() == 1 && snapshot->windows[needle[0]].address == 0x1217);
+    CHECK(needle.size() == 1 && snapshot->workspaces[search.record_of(needle[0])].id == 217 % 20 + 1);
+
+    // Typing one character at a time narrows; every step answers like a fresh search
+    const std::string typed = "number 21";
+    for (size_t length = 1; length <= typed.size(); length++) {
+        std::vector<uint32_t> narrowed = search.query(typed.substr(0, length));
+        WindowSearch fresh;
+        fresh.build(*snapshot);
+        CHECK(narrowed == fresh.query(typed.substr(0, length)));
+    }
+    CHECK(search.query("number 21").size() == 11); // 21 and 210-219
+}
+
+static void test_rank() {
+    auto snapshot = make_snapshot("[" + client("0x1", "kitty", "notes - vim", 1) + "," +
+                                      client("0x2", "firefox", "vim tips", 2) + "," + client("0x3", "Vim", "x", 3) +
+                                      "," + client("0x4", "foot", "more vim", 4) + "]",
+                                  4);
+    WindowSearch search;
+    search.build(*snapshot);
+    std::vector<uint32_t> ranked = search.rank(search.query("vim"), "vim", *snapshot);
+    std::vector<uint64_t> addresses;
+    for (uint32_t w : ranked) {
+        addresses.push_back(snapshot->windows[w].address);
+    }
+    // Exact class, then title prefix, then the rest with the active workspace first
+    CHECK((addresses == std::vector<uint64_t>{0x3, 0x2, 0x4, 0x1}));
+}
+
+int main() {
+    test_query();
+    test_rank();
+    return check_result("window-search");
+}
@@ -0,0 +1,54 @@
+// Saved workspace contents: a round trip keeps every row, and a file cut short
+// anywhere, from another version or with a count out of range loads as empty.
+#include "check.hpp"
+#include "workspace-contents.hpp"
+
+static std::string read_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+static void write_file(const std::string& path, const std::string& data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+int main() {
+    ScratchDir scratch;
+    std::string path = scratch.path("contents");
+    std::vector<WorkspaceContents::Row> rows(3);
+    rows[0].slot = 1;
+    rows[0].classes_hash = 0x1234567890abcdef;
+    rows[0].classes = {{"firefox", 2}, {"kitty", 1}};
+    rows[1].slot = 13;
+    rows[1].classes_hash = 7;
+    rows[1].classes = {{"", 1}}; // Windows without a class
+    rows[2].slot = 20;
+    CHECK(WorkspaceContents::save(path, rows));
+
+    std::vector<WorkspaceContents::Row> loaded = WorkspaceContents::load(path);
+    CHECK(loaded.size() == rows.size());
+    for (size_t r = 0; r < loaded.size() && r < rows.size(); r++) {
+        CHECK(loaded[r].slot == rows[r].slot);
+        CHECK(loaded[r].classes_hash == rows[r].classes_hash);
+        CHECK(loaded[r].classes == rows[r].classes);
+    }
+
+    std::string data = read_file(path);
+    for (size_t length = 0; length < data.size(); length++) {
+        write_file(path, data.substr(0, length));
+        CHECK(WorkspaceContents::load(path).empty());
+    }
+    std::string other_version = data;
+    other_version[4]++;
+    write_file(path, other_version);
+    CHECK(WorkspaceContents::load(path).empty());
+    std::string too_many_rows = data;
+    too_many_rows[8] = static_cast<char>(WorkspaceContents::max_rows + 1);
+    write_file(path, too_many_rows);
+    CHECK(WorkspaceContents::load(path).empty());
+    CHECK(WorkspaceContents::load(scratch.path("missing")).empty());
+    return check_result("workspace-contents");
+}
@@ -0,0 +1,262 @@
+// Themes are data: an INI file describes each theme's icon directory, glow
+// colors and sizes, and the switcher turns the selected one into CSS. The
+// generated CSS is cached next to a stamp of its inputs, so a launch with
+// nothing changed costs two stat() calls and one small read.
+//
+//   [ely]
+//   match=ely                     ; substring of ~/.config/hypr/Light.txt selecting it
+//   icon-dir=~/.config/Elysia/assets/workspace/
+//   font=ElysiaOSNew12
+//   glow-size=20                  ; outer glow step, px (inset-glow-size for the inner one)
+//   center-glow-size=30           ; the same for the special workspace in the center
+//   pulse-seconds=1.5
+//   color-1=173,216,230           ; hover color per workspace, 1-13, and color-extra
+//   inset-color-4=255,255,224     ; optional inner glow color, defaults to color-N
+//
+// The theme with the longest match appearing in the selector file wins, so
+// "cyrene" beats "ely" in a file naming both; ties go to the earlier theme.
+// With none matching, the first theme is used.
+#pragma once
+
+#include <sys/stat.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct Theme {
+    static constexpr int color_count = 15; // 1-13, 14 = extra workspaces; 0 unused
+
+    std::string name;
+    std::string match;
+    std::string icon_dir;
+    std::string font = "ElysiaOSNew12";
+    int glow_size = 20;
+    int inset_glow_size = 15;
+    int center_glow_size = 30;
+    int center_inset_glow_size = 20;
+    double pulse_seconds = 1.5;
+    double center_pulse_seconds = 1.2;
+    std::string colors[color_count];
+    std::string inset_colors[color_count];
+};
+
+class ThemeEngine {
+public:
+    struct Resolved {
+        std::string name;
+        std::string icon_dir;
+        std::string css;
+    };
+
+    // The two themes ElysiaOS ships, used when there is no theme file
+    static std::vector<Theme> builtin_themes() {
+        static const char* colors[Theme::color_count] = {
+            "",            "173,216,230", "0,100,255",   "255,215,0",   "255,235,164",
+            "233,28,32",   "144,238,144", "255,182,193", "255,255,255", "0,255,0",
+            "135,206,235", "248,248,255", "255,192,203", "255,20,147",  "230,190,255",
+        };
+        Theme ely;
+        ely.name = "ely";
+        ely.match = "ely";
+        ely.icon_dir = "~/.config/Elysia/assets/workspace/";
+        for (int i = 1; i < Theme::color_count; i++) {
+            ely.colors[i] = colors[i];
+        }
+        ely.inset_colors[4] = "255,255,224";
+        ely.inset_colors[5] = "203,28,32";
+        Theme cyrene = ely;
+        cyrene.name = "cyrene";
+        cyrene.match = "cyrene";
+        cyrene.icon_dir = "~/.config/Elysia/assets/workspace/AMPH/";
+        return {ely, cyrene};
+    }
+
+    // Unknown keys are ignored so older switchers read newer files
+    static std::vector<Theme> parse(const std::string& text) {
+        std::vector<Theme> themes;
+        Theme defaults = builtin_themes().front();
+        std::istringstream lines(text);
+        std::string line;
+        while (std::getline(lines, line)) {
+            line = trim(line.substr(0, line.find_first_of(";#")));
+            if (line.empty()) {
+                continue;
+            }
+            if (line.front() == '[' && line.back() == ']') {
+                themes.push_back(defaults);
+                themes.back().name = trim(line.substr(1, line.size() - 2));
+                themes.back().match = themes.back().name;
+                continue;
+            }
+            size_t equals = line.find('=');
+            if (themes.empty() || equals == std::string::npos) {
+                continue;
+            }
+            set_key(themes.back(), trim(line.substr(0, equals)), trim(line.substr(equals + 1)));
+        }
+        return themes;
+    }
+
+    static const Theme& select(const std::vector<Theme>& themes, const std::string& selector) {
+        const Theme* best = &themes.front();
+        size_t best_length = 0;
+        for (const Theme& theme : themes) {
+            if (theme.match.size() > best_length && selector.find(theme.match) != std::string::npos) {
+                best = &theme;
+                best_length = theme.match.size();
+            }
+        }
+        return *best;
+    }
+
+    // Theme-dependent rules: fonts and the per-workspace hover glow
+    static std::string css(const Theme& theme) {
+        std::ostringstream out;
+        out << ".search-label, .page-indicator, .tooltip-window { font-family: " << theme.font << "; }\n";
+        for (int i = 1; i < Theme::color_count; i++) {
+            bool center = i == 13;
+            std::string color = theme.colors[i].empty() ? theme.colors[14] : theme.colors[i];
+            std::string inset = theme.inset_colors[i].empty() ? color : theme.inset_colors[i];
+            int glow = center ? theme.center_glow_size : theme.glow_size;
+            int inset_glow = center ? theme.center_inset_glow_size : theme.inset_glow_size;
+            out << (i == 14 ? std::string(".workspace-extra") : ".workspace-" + std::to_string(i))
+                << ":hover {\n    color: rgb(" << color << ");\n    box-shadow:\n"
+                << "        inset 0 0 " << inset_glow << "px rgba(" << inset << ", " << (center ? "0.7" : "0.6") << "),\n"
+                << "        inset 0 0 " << inset_glow * 2 << "px rgba(" << inset << ", " << (center ? "0.5" : "0.4") << "),\n"
+                << "        0 0 " << glow << "px rgb(" << color << "),\n"
+                << "        0 0 " << glow * 2 << "px rgb(" << color << "),\n"
+                << "        0 0 " << glow * 3 << "px rgb(" << color << ");\n"
+                << "    animation: pulse-glow " << (center ? theme.center_pulse_seconds : theme.pulse_seconds)
+                << "s infinite ease-in-out;\n}\n";
+        }
+        return out.str();
+    }
+
+    // The theme the selector file picks from the theme file, or from the built-in themes
+    static Theme load(const std::string& themes_path, const std::string& selector_path) {
+        std::vector<Theme> themes = parse(read_file(themes_path));
+        if (themes.empty()) {
+            themes = builtin_themes();
+        }
+        return select(themes, read_file(selector_path));
+    }
+
+    // "r,g,b" as 0-1 components, for drawing outside CSS
+    static bool parse_rgb(const std::string& value, double& r, double& g, double& b) {
+        int red, green, blue;
+        if (std::sscanf(value.c_str(), "%d , %d , %d", &red, &green, &blue) != 3) {
+            return false;
+        }
+        r = red / 255.0;
+        g = green / 255.0;
+        b = blue / 255.0;
+        return true;
+    }
+
+    // Selected theme for the current inputs, from the cache when its stamp still matches
+    static Resolved resolve(const std::string& themes_path, const std::string& selector_path,
+                            const std::string& cache_path) {
+        std::string key = "v1 " + stamp(themes_path) + " " + stamp(selector_path);
+        Resolved resolved;
+        if (read_cache(cache_path, key, resolved)) {
+            return resolved;
+        }
+        Theme theme = load(themes_path, selector_path);
+        resolved.name = theme.name;
+        resolved.icon_dir = expand_home(theme.icon_dir);
+        if (!resolved.icon_dir.empty() && resolved.icon_dir.back() != '/') {
+            resolved.icon_dir += '/';
+        }
+        resolved.css = css(theme);
+        write_cache(cache_path, key, resolved);
+        return resolved;
+    }
+
+    static std::string expand_home(const std::string& path) {
+        const char* home = getenv("HOME");
+        if (path.rfind("~/", 0) == 0) {
+            return std::string(home ? home : "") + path.substr(1);
+        }
+        return path;
+    }
+
+private:
+    static std::string trim(const std::string& value) {
+        size_t first = value.find_first_not_of(" \t\r");
+        if (first == std::string::npos) {
+            return "";
+        }
+        return value.substr(first, value.find_last_not_of(" \t\r") - first + 1);
+    }
+
+    static void set_key(Theme& theme, const std::string& key, const std::string& value) {
+        if (key == "match") theme.match = value;
+        else if (key == "icon-dir") theme.icon_dir = value;
+        else if (key == "font") theme.font = value;
+        else if (key == "glow-size") theme.glow_size = std::atoi(value.c_str());
+        else if (key == "inset-glow-size") theme.inset_glow_size = std::atoi(value.c_str());
+        else if (key == "center-glow-size") theme.center_glow_size = std::atoi(value.c_str());
+        else if (key == "center-inset-glow-size") theme.center_inset_glow_size = std::atoi(value.c_str());
+        else if (key == "pulse-seconds") theme.pulse_seconds = std::atof(value.c_str());
+        else if (key == "center-pulse-seconds") theme.center_pulse_seconds = std::atof(value.c_str());
+        else if (key == "color-extra") theme.colors[14] = value;
+        else if (key == "inset-color-extra") theme.inset_colors[14] = value;
+        else if (key.rfind("color-", 0) == 0) set_color(theme.colors, key.substr(6), value);
+        else if (key.rfind("inset-color-", 0) == 0) set_color(theme.inset_colors, key.substr(12), value);
+    }
+
+    static void set_color(std::string* colors, const std::string& index, const std::string& value) {
+        int i = std::atoi(index.c_str());
+        if (i >= 1 && i <= 13) {
+            colors[i] = value;
+        }
+    }
+
+    // Size and modification time; "-" for a missing file, which is a valid input too
+    static std::string stamp(const std::string& path) {
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) {
+            return "-";
+        }
+        return std::to_string(st.st_size) + ":" + std::to_string(st.st_mtim.tv_sec) + "." +
+               std::to_string(st.st_mtim.tv_nsec);
+    }
+
+    static std::string read_file(const std::string& path) {
+        std::ifstream file(path);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // Cache layout: key, theme name and icon directory on one line each, then the CSS
+    static bool read_cache(const std::string& path, const std::string& key, Resolved& resolved) {
+        std::ifstream file(path);
+        std::string cached_key;
+        if (!std::getline(file, cached_key) || cached_key != key || !std::getline(file, resolved.name) ||
+            !std::getline(file, resolved.icon_dir)) {
+            return false;
+        }
+        std::ostringstream css;
+        css << file.rdbuf();
+        resolved.css = css.str();
+        return true;
+    }
+
+    static void write_cache(const std::string& path, const std::string& key, const Resolved& resolved) {
+        std::string dir = path.substr(0, path.find_last_of('/'));
+        mkdir(dir.c_str(), 0700);
+        std::string tmp_path = path + ".tmp";
+        {
+            std::ofstream file(tmp_path, std::ios::trunc);
+            file << key << "\n" << resolved.name << "\n" << resolved.icon_dir << "\n" << resolved.css;
+            if (!file) {
+                return;
+            }
+        }
+        std::rename(tmp_path.c_str(), path.c_str());
+    }
+};
@@ -0,0 +1,71 @@
+// Bulk window moves compiled into a single [[BATCH]] request of
+// movetoworkspacesilent dispatches, so reshuffling thirty windows is one IPC
+// round trip instead of thirty hyprctl spawns. Windows are picked from one
+// snapshot up front, which keeps swaps correct however the batch is ordered.
+#pragma once
+
+#include "hypr-ipc.hpp"
+#include "workspace-model.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+class WindowMoves {
+public:
+    // Dispatcher targets end at ',' and batch commands at ';', so names holding either are refused
+    static bool is_safe_target(const std::string& target) {
+        return !target.empty() && target.find_first_of(",;") == std::string::npos;
+    }
+
+    void add(uint64_t address, const std::string& target) {
+        moves.emplace_back(address, target);
+    }
+
+    // Every window of a workspace
+    void move_workspace(const WorkspaceSnapshot& snapshot, const WorkspaceRecord& from, const std::string& target) {
+        for (uint32_t w = from.first_window; w < from.first_window + from.window_count; w++) {
+            add(snapshot.windows[w].address, target);
+        }
+    }
+
+    // Windows of one class, from a single workspace or from all of them when from is null
+    void move_class(const WorkspaceSnapshot& snapshot, const WorkspaceRecord* from, const std::string& app_class,
+                    const std::string& target) {
+        uint32_t first = from ? from->first_window : 0;
+        uint32_t end = from ? from->first_window + from->window_count : static_cast<uint32_t>(snapshot.windows.size());
+        for (uint32_t w = first; w < end; w++) {
+            if (snapshot.str(snapshot.windows[w].class_id) == app_class) {
+                add(snapshot.windows[w].address, target);
+            }
+        }
+    }
+
+    size_t size() const {
+        return moves.size();
+    }
+
+    std::string command() const {
+        std::string batch = "[[BATCH]]";
+        char address[32];
+        for (size_t i = 0; i < moves.size(); i++) {
+            std::snprintf(address, sizeof(address), "%llx", static_cast<unsigned long long>(moves[i].first));
+            batch += (i ? ";" : "") + std::string("dispatch movetoworkspacesilent ") + moves[i].second +
+                     ",address:0x" + address;
+        }
+        return batch;
+    }
+
+    // One round trip, failed when any dispatch in the batch answers with an error
+    bool send(std::string& reply) const {
+        if (moves.empty()) {
+            reply.clear();
+            return true;
+        }
+        return HyprIPC::dispatch(command(), reply);
+    }
+
+private:
+    std::vector<std::pair<uint64_t, std::string>> moves; // Window address, target workspace
+};
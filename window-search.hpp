@@ -0,0 +1,158 @@
+// Type-to-search over every window in a workspace snapshot. A trigram index
+// answers queries of three or more characters, shorter ones scan, and a query
+// that extends the previous one only re-checks the previous matches.
+#pragma once
+
+#include "workspace-model.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class WindowSearch {
+public:
+    // Indexes titles and classes; queries are answered against this snapshot until the next build
+    void build(const WorkspaceSnapshot& snapshot) {
+        built_version = snapshot.version;
+        built = true;
+        haystacks.clear();
+        window_records.clear();
+        postings.clear();
+        last_query.clear();
+        last_results.clear();
+        haystacks.reserve(snapshot.windows.size());
+        window_records.resize(snapshot.windows.size());
+        for (size_t r = 0; r < snapshot.workspaces.size(); r++) {
+            const WorkspaceRecord& record = snapshot.workspaces[r];
+            for (uint32_t w = record.first_window; w < record.first_window + record.window_count; w++) {
+                window_records[w] = static_cast<uint32_t>(r);
+            }
+        }
+        for (uint32_t w = 0; w < snapshot.windows.size(); w++) {
+            const WindowEntry& window = snapshot.windows[w];
+            // The separator never appears in a query, so no trigram spans title and class
+            haystacks.push_back(fold(snapshot.str(window.title_id)) + "\n" + fold(snapshot.str(window.class_id)));
+            const std::string& text = haystacks.back();
+            for (size_t i = 0; i + 3 <= text.size(); i++) {
+                std::vector<uint32_t>& list = postings[trigram(text.data() + i)];
+                if (list.empty() || list.back() != w) {
+                    list.push_back(w); // Windows are visited in order, so lists stay sorted
+                }
+            }
+        }
+    }
+
+    bool is_built_for(uint64_t version) const {
+        return built && built_version == version;
+    }
+
+    // Indices into the snapshot's windows whose title or class contains text
+    // (ASCII case-insensitive), in snapshot order
+    const std::vector<uint32_t>& query(const std::string& text) {
+        std::string needle = fold(text);
+        std::vector<uint32_t> candidates;
+        if (needle.empty()) {
+            last_results.clear();
+        } else if (!last_query.empty() && needle.compare(0, last_query.size(), last_query) == 0 &&
+                   (last_query.size() >= 3 || needle.size() < 3)) {
+            candidates.swap(last_results); // Narrowing: only earlier matches can still match
+        } else if (needle.size() >= 3) {
+            candidates = trigram_candidates(needle);
+        } else {
+            candidates.resize(haystacks.size());
+            for (uint32_t w = 0; w < candidates.size(); w++) candidates[w] = w;
+        }
+        last_results.clear();
+        for (uint32_t w : candidates) {
+            if (haystacks[w].find(needle) != std::string::npos) {
+                last_results.push_back(w);
+            }
+        }
+        last_query = needle;
+        return last_results;
+    }
+
+    // Best first: windows whose title or class is the query, then those starting with it,
+    // then the rest; within each, the active workspace first, then by workspace id
+    // (snapshot order). query() keeps snapshot order so narrowing stays cheap.
+    std::vector<uint32_t> rank(const std::vector<uint32_t>& matches, const std::string& text,
+                               const WorkspaceSnapshot& snapshot) const {
+        std::string needle = fold(text);
+        std::vector<std::pair<uint32_t, uint32_t>> keyed; // Sort key, window
+        keyed.reserve(matches.size());
+        for (uint32_t w : matches) {
+            const std::string& haystack = haystacks[w];
+            size_t separator = haystack.find('\n');
+            std::string title = haystack.substr(0, separator);
+            std::string app_class = haystack.substr(separator + 1);
+            uint32_t tier = title == needle || app_class == needle                               ? 0
+                            : title.compare(0, needle.size(), needle) == 0 ||
+                                      app_class.compare(0, needle.size(), needle) == 0 ? 1
+                                                                                        : 2;
+            bool active = snapshot.workspaces[window_records[w]].id == snapshot.active_workspace;
+            keyed.emplace_back(tier * 2 + (active ? 0 : 1), w);
+        }
+        std::stable_sort(keyed.begin(), keyed.end(),
+                         [](const std::pair<uint32_t, uint32_t>& a, const std::pair<uint32_t, uint32_t>& b) {
+                             return a.first < b.first;
+                         });
+        std::vector<uint32_t> ranked;
+        ranked.reserve(keyed.size());
+        for (const auto& entry : keyed) {
+            ranked.push_back(entry.second);
+        }
+        return ranked;
+    }
+
+    // Index into the snapshot's workspaces of the record holding a window
+    uint32_t record_of(uint32_t window) const {
+        return window_records[window];
+    }
+
+private:
+    static std::string fold(const std::string& value) {
+        std::string folded = value;
+        for (char& c : folded) {
+            if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        }
+        return folded;
+    }
+
+    static uint32_t trigram(const char* p) {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(p[0])) << 16) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(p[1])) << 8) | static_cast<unsigned char>(p[2]);
+    }
+
+    // Windows containing every trigram of the needle, intersecting the shortest lists first
+    std::vector<uint32_t> trigram_candidates(const std::string& needle) const {
+        std::vector<const std::vector<uint32_t>*> lists;
+        for (size_t i = 0; i + 3 <= needle.size(); i++) {
+            auto it = postings.find(trigram(needle.data() + i));
+            if (it == postings.end()) {
+                return {};
+            }
+            lists.push_back(&it->second);
+        }
+        std::sort(lists.begin(), lists.end(),
+                  [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) { return a->size() < b->size(); });
+        std::vector<uint32_t> result = *lists.front();
+        std::vector<uint32_t> next;
+        for (size_t i = 1; i < lists.size() && !result.empty(); i++) {
+            next.clear();
+            std::set_intersection(result.begin(), result.end(), lists[i]->begin(), lists[i]->end(),
+                                  std::back_inserter(next));
+            result.swap(next);
+        }
+        return result;
+    }
+
+    bool built = false;
+    uint64_t built_version = 0;
+    std::vector<std::string> haystacks;     // Folded "title\nclass" per window
+    std::vector<uint32_t> window_records;   // Per window
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings; // Trigram -> sorted window indices
+    std::string last_query;
+    std::vector<uint32_t> last_results;
+};
@@ -0,0 +1,121 @@
+// Last known app classes per workspace, saved on exit so the next launch can
+// lay out icon rows before the first snapshot arrives. Each row keeps the
+// classes_hash it was built from; the first snapshot confirms rows whose hash
+// still matches and rebuilds the rest.
+//
+// Binary, host byte order (a per-user cache, never shared between machines):
+//   u32 magic, u32 version, u32 row count, then per row
+//   i32 slot, u64 classes_hash, u32 class count, then per class
+//   u32 window count, u16 length, class bytes
+// Anything truncated or out of range discards the whole file.
+#pragma once
+
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+class WorkspaceContents {
+public:
+    static constexpr uint32_t magic = 0x52435745; // "EWCR"
+    static constexpr uint32_t version = 1;
+    static constexpr uint32_t max_rows = 64;
+    static constexpr uint32_t max_classes = 256;
+
+    struct Row {
+        int slot = 0;
+        uint64_t classes_hash = 0;
+        std::vector<std::pair<std::string, uint32_t>> classes; // Class, window count, in row order
+    };
+
+    // Written next to the target and renamed, so a crash never leaves half a file
+    static bool save(const std::string& path, const std::vector<Row>& rows) {
+        std::string data;
+        put(data, magic);
+        put(data, version);
+        put(data, static_cast<uint32_t>(std::min<size_t>(rows.size(), max_rows)));
+        for (size_t r = 0; r < rows.size() && r < max_rows; r++) {
+            const Row& row = rows[r];
+            uint32_t class_count = static_cast<uint32_t>(std::min<size_t>(row.classes.size(), max_classes));
+            put(data, static_cast<int32_t>(row.slot));
+            put(data, row.classes_hash);
+            put(data, class_count);
+            for (uint32_t c = 0; c < class_count; c++) {
+                const std::string& app_class = row.classes[c].first;
+                uint16_t length = static_cast<uint16_t>(std::min<size_t>(app_class.size(), UINT16_MAX));
+                put(data, row.classes[c].second);
+                put(data, length);
+                data.append(app_class, 0, length);
+            }
+        }
+        std::string dir = path.substr(0, path.find_last_of('/'));
+        mkdir(dir.c_str(), 0700);
+        std::string tmp_path = path + ".tmp";
+        {
+            std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!file) {
+                return false;
+            }
+        }
+        return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+    }
+
+    // Empty when the file is missing, from another version or damaged
+    static std::vector<Row> load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        std::string data = content.str();
+        size_t offset = 0;
+        uint32_t file_magic, file_version, row_count;
+        std::vector<Row> rows;
+        if (!get(data, offset, file_magic) || file_magic != magic || !get(data, offset, file_version) ||
+            file_version != version || !get(data, offset, row_count) || row_count > max_rows) {
+            return rows;
+        }
+        for (uint32_t r = 0; r < row_count; r++) {
+            Row row;
+            int32_t slot;
+            uint32_t class_count;
+            if (!get(data, offset, slot) || !get(data, offset, row.classes_hash) || !get(data, offset, class_count) ||
+                class_count > max_classes) {
+                return {};
+            }
+            row.slot = slot;
+            for (uint32_t c = 0; c < class_count; c++) {
+                uint32_t windows;
+                uint16_t length;
+                if (!get(data, offset, windows) || !get(data, offset, length) || data.size() - offset < length) {
+                    return {};
+                }
+                row.classes.emplace_back(data.substr(offset, length), windows);
+                offset += length;
+            }
+            rows.push_back(std::move(row));
+        }
+        return rows;
+    }
+
+private:
+    template <typename T>
+    static void put(std::string& data, T value) {
+        data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    static bool get(const std::string& data, size_t& offset, T& value) {
+        if (data.size() - offset < sizeof(value)) {
+            return false;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(value));
+        offset += sizeof(value);
+        return true;
+    }
+};
@@ -0,0 +1,384 @@
+// Workspace model: immutable, versioned snapshots of every workspace and every
+// window on it, built from one clients and one workspaces query. An IPC thread
+// publishes them and the UI takes them by atomic pointer swap, so neither side
+// ever locks.
+#pragma once
+
+#include "hypr-ipc.hpp"
+#include "switcher-metrics.hpp"
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct WindowEntry {
+    uint64_t address;
+    uint32_t class_id; // Index into WorkspaceSnapshot::strings
+    uint32_t title_id;
+    int32_t x, y, width, height; // Layout coordinates from "at" and "size"
+};
+
+// Output area in layout coordinates (logical pixels, rotation applied)
+struct MonitorRect {
+    int id;
+    int32_t x, y, width, height;
+};
+
+// One workspace: a contiguous range of WorkspaceSnapshot::windows plus content
+// hashes the UI compares across snapshots to find what changed. The hashes are
+// 0 for a workspace without windows, the same as for one that doesn't exist.
+struct WorkspaceRecord {
+    int id;          // Special workspaces are negative
+    uint32_t name_id; // "3", "music", "special:elysia"
+    uint32_t first_window;
+    uint32_t window_count;
+    uint64_t classes_hash; // Changes when the app icon row would
+    uint64_t titles_hash;  // Changes when the tooltip list would
+    uint64_t layout_hash;  // Changes when the window geometry would
+    int monitor;           // -1 if unknown
+};
+
+class WorkspaceSnapshot {
+public:
+    uint64_t version = 0;
+    std::vector<std::string> strings{""};    // Interned classes, titles and workspace names; 0 is ""
+    std::vector<WindowEntry> windows;        // Grouped by workspace, compositor order within each
+    std::vector<WorkspaceRecord> workspaces; // Sorted by id
+    std::vector<MonitorRect> monitors;
+    int active_workspace = 0; // On the focused monitor; 0 if unknown
+
+    const std::string& str(uint32_t id) const {
+        return strings[id];
+    }
+
+    const WorkspaceRecord* find(int id) const {
+        for (const auto& record : workspaces) {
+            if (record.id == id) return &record;
+        }
+        return nullptr;
+    }
+
+    const WorkspaceRecord* find_by_name(const std::string& name) const {
+        for (const auto& record : workspaces) {
+            if (strings[record.name_id] == name) return &record;
+        }
+        return nullptr;
+    }
+
+    const WindowEntry* windows_begin(const WorkspaceRecord& record) const {
+        return windows.data() + record.first_window;
+    }
+
+    const WindowEntry* windows_end(const WorkspaceRecord& record) const {
+        return windows.data() + record.first_window + record.window_count;
+    }
+
+    // Area a workspace's windows are laid out in: its monitor, or the box around
+    // its windows when the monitor is unknown. False if there is nothing to show.
+    bool layout_bounds(const WorkspaceRecord& record, MonitorRect& bounds) const {
+        for (const auto& monitor : monitors) {
+            if (monitor.id == record.monitor) {
+                bounds = monitor;
+                return bounds.width > 0 && bounds.height > 0;
+            }
+        }
+        if (record.window_count == 0) {
+            return false;
+        }
+        int32_t x1 = INT32_MAX, y1 = INT32_MAX, x2 = INT32_MIN, y2 = INT32_MIN;
+        for (const WindowEntry* w = windows_begin(record); w != windows_end(record); ++w) {
+            x1 = std::min(x1, w->x);
+            y1 = std::min(y1, w->y);
+            x2 = std::max(x2, w->x + w->width);
+            y2 = std::max(y2, w->y + w->height);
+        }
+        bounds = {record.monitor, x1, y1, x2 - x1, y2 - y1};
+        return bounds.width > 0 && bounds.height > 0;
+    }
+
+    // Distinct non-empty classes on a workspace with their window counts, in order
+    // of first appearance. Works on interned ids, so no string is compared.
+    std::vector<std::pair<uint32_t, uint32_t>> class_counts(const WorkspaceRecord& record) const {
+        std::vector<std::pair<uint32_t, uint32_t>> counts;
+        for (const WindowEntry* w = windows_begin(record); w != windows_end(record); ++w) {
+            if (w->class_id == 0) {
+                continue;
+            }
+            auto it = std::find_if(counts.begin(), counts.end(),
+                                   [w](const std::pair<uint32_t, uint32_t>& c) { return c.first == w->class_id; });
+            if (it != counts.end()) {
+                it->second++;
+            } else {
+                counts.emplace_back(w->class_id, 1);
+            }
+        }
+        return counts;
+    }
+
+    // Builds a snapshot from the replies to "j/clients", "j/workspaces" and "j/monitors"
+    static std::unique_ptr<WorkspaceSnapshot> from_ipc(const JsonValue& clients, const JsonValue& workspaces,
+                                                       const JsonValue& monitors, uint64_t version) {
+        auto snapshot = std::make_unique<WorkspaceSnapshot>();
+        snapshot->version = version;
+        std::unordered_map<std::string, uint32_t> interned{{"", 0}};
+        auto intern = [&](const std::string& value) -> uint32_t {
+            auto it = interned.find(value);
+            if (it != interned.end()) return it->second;
+            uint32_t id = static_cast<uint32_t>(snapshot->strings.size());
+            snapshot->strings.push_back(value);
+            interned.emplace(value, id);
+            return id;
+        };
+        struct Placed {
+            int workspace_id;
+            uint32_t workspace_name;
+            int monitor;
+            WindowEntry window;
+        };
+        std::vector<Placed> placed;
+        placed.reserve(clients.items.size());
+        for (const JsonValue& client : clients.items) {
+            const JsonValue& workspace = client["workspace"];
+            WindowEntry window;
+            window.address = std::strtoull(client["address"].as_string().c_str(), nullptr, 16);
+            window.class_id = intern(client["class"].as_string());
+            window.title_id = intern(client["title"].as_string());
+            window.x = pair_value(client["at"], 0);
+            window.y = pair_value(client["at"], 1);
+            window.width = pair_value(client["size"], 0);
+            window.height = pair_value(client["size"], 1);
+            placed.push_back({workspace["id"].as_int(), intern(workspace["name"].as_string()),
+                              client["monitor"].as_int(-1), window});
+        }
+        std::stable_sort(placed.begin(), placed.end(),
+                         [](const Placed& a, const Placed& b) { return a.workspace_id < b.workspace_id; });
+        snapshot->windows.reserve(placed.size());
+        for (const Placed& p : placed) {
+            if (snapshot->workspaces.empty() || snapshot->workspaces.back().id != p.workspace_id) {
+                uint32_t first = static_cast<uint32_t>(snapshot->windows.size());
+                snapshot->workspaces.push_back(
+                    {p.workspace_id, p.workspace_name, first, 0, fnv_offset, fnv_offset, fnv_offset, p.monitor});
+            }
+            WorkspaceRecord& record = snapshot->workspaces.back();
+            record.window_count++;
+            record.classes_hash = fnv_append(record.classes_hash, snapshot->strings[p.window.class_id]);
+            record.titles_hash = fnv_append(record.titles_hash, snapshot->strings[p.window.title_id]);
+            int32_t geometry[4] = {p.window.x, p.window.y, p.window.width, p.window.height};
+            record.layout_hash = fnv_append(record.layout_hash, std::string(reinterpret_cast<const char*>(geometry),
+                                                                             sizeof(geometry)));
+            snapshot->windows.push_back(p.window);
+        }
+        // Workspaces that exist without windows (the active one, persistent ones)
+        size_t with_windows = snapshot->workspaces.size();
+        for (const JsonValue& workspace : workspaces.items) {
+            int id = workspace["id"].as_int();
+            bool known = std::any_of(snapshot->workspaces.begin(), snapshot->workspaces.begin() + with_windows,
+                                     [id](const WorkspaceRecord& record) { return record.id == id; });
+            if (!known) {
+                uint32_t first = static_cast<uint32_t>(snapshot->windows.size());
+                snapshot->workspaces.push_back(
+                    {id, intern(workspace["name"].as_string()), first, 0, 0, 0, 0, workspace["monitorID"].as_int(-1)});
+            }
+        }
+        std::sort(snapshot->workspaces.begin(), snapshot->workspaces.end(),
+                  [](const WorkspaceRecord& a, const WorkspaceRecord& b) { return a.id < b.id; });
+        for (const JsonValue& monitor : monitors.items) {
+            if (monitor["focused"].boolean) {
+                snapshot->active_workspace = monitor["activeWorkspace"]["id"].as_int();
+            }
+            // Reported in device pixels; window geometry is logical
+            double scale = monitor["scale"].type == JsonValue::NUMBER && monitor["scale"].number > 0
+                               ? monitor["scale"].number : 1.0;
+            int32_t width = static_cast<int32_t>(monitor["width"].as_int() / scale);
+            int32_t height = static_cast<int32_t>(monitor["height"].as_int() / scale);
+            if (monitor["transform"].as_int() % 2 == 1) {
+                std::swap(width, height); // Rotated 90 or 270 degrees
+            }
+            snapshot->monitors.push_back({monitor["id"].as_int(-1), monitor["x"].as_int(), monitor["y"].as_int(),
+                                          width, height});
+        }
+        return snapshot;
+    }
+
+private:
+    static constexpr uint64_t fnv_offset = 1469598103934665603ULL;
+
+    // "at" and "size" are [x, y] arrays
+    static int32_t pair_value(const JsonValue& pair, size_t index) {
+        return pair[index].as_int();
+    }
+
+    static uint64_t fnv_append(uint64_t hash, const std::string& value) {
+        for (unsigned char c : value) {
+            hash = (hash ^ c) * 1099511628211ULL;
+        }
+        return (hash ^ 0xFF) * 1099511628211ULL; // Separator so "ab","c" != "a","bc"
+    }
+};
+
+// Single-producer/single-consumer handoff of the newest snapshot. Publishing
+// replaces (and frees) a snapshot the consumer never took; taking empties the slot.
+class SnapshotMailbox {
+public:
+    ~SnapshotMailbox() {
+        delete slot.exchange(nullptr);
+    }
+
+    void publish(std::unique_ptr<const WorkspaceSnapshot> snapshot) {
+        delete slot.exchange(snapshot.release(), std::memory_order_acq_rel);
+    }
+
+    std::unique_ptr<const WorkspaceSnapshot> take() {
+        return std::unique_ptr<const WorkspaceSnapshot>(slot.exchange(nullptr, std::memory_order_acq_rel));
+    }
+
+private:
+    std::atomic<const WorkspaceSnapshot*> slot{nullptr};
+};
+
+// Owns the IPC thread: publishes a snapshot on start and again whenever the
+// compositor reports a window or workspace change. on_publish runs on the IPC
+// thread and should only schedule the UI to call take(). IPC round trips and
+// snapshot builds are recorded into metrics when one is given.
+class WorkspaceModel {
+public:
+    explicit WorkspaceModel(std::function<void()> on_publish, Metrics* metrics = nullptr)
+        : on_publish(std::move(on_publish)), metrics(metrics) {}
+
+    ~WorkspaceModel() {
+        stop();
+    }
+
+    void start() {
+        wake_fd = eventfd(0, EFD_CLOEXEC);
+        thread = std::thread(&WorkspaceModel::run, this);
+    }
+
+    void stop() {
+        if (!thread.joinable()) {
+            return;
+        }
+        stopping = true;
+        uint64_t one = 1;
+        ssize_t n = write(wake_fd, &one, sizeof(one));
+        (void)n;
+        thread.join();
+        close(wake_fd);
+    }
+
+    std::unique_ptr<const WorkspaceSnapshot> take() {
+        return mailbox.take();
+    }
+
+    // Queries clients, workspaces and monitors once and publishes the result
+    bool refresh() {
+        JsonValue clients;
+        JsonValue workspaces;
+        JsonValue monitors;
+        if (!timed_request("clients", clients) || clients.type != JsonValue::ARRAY) {
+            return false;
+        }
+        // Optional: they only add windowless workspaces and minimap bounds
+        timed_request("workspaces", workspaces);
+        timed_request("monitors", monitors);
+        auto start = std::chrono::steady_clock::now();
+        auto snapshot = WorkspaceSnapshot::from_ipc(clients, workspaces, monitors, ++version);
+        if (metrics) {
+            metrics->observe("snapshot_build", Metrics::elapsed_ms(start));
+            metrics->count("snapshots");
+        }
+        mailbox.publish(std::move(snapshot));
+        if (on_publish) {
+            on_publish();
+        }
+        return true;
+    }
+
+private:
+    bool timed_request(const std::string& command, JsonValue& out) {
+        auto start = std::chrono::steady_clock::now();
+        bool ok = HyprIPC::request_json(command, out);
+        if (metrics) {
+            metrics->observe("ipc_rtt", Metrics::elapsed_ms(start));
+            if (!ok) metrics->count("ipc_errors");
+        }
+        return ok;
+    }
+
+    // Bursts (closing a workspace full of windows) collapse into one refresh
+    static constexpr int coalesce_ms = 16;
+
+    static bool is_model_event(const std::string& event) {
+        static const char* names[] = {
+            "openwindow", "closewindow", "movewindow", "movewindowv2", "windowtitle", "windowtitlev2",
+            "createworkspace", "createworkspacev2", "destroyworkspace", "destroyworkspacev2",
+            "renameworkspace", "moveworkspace", "moveworkspacev2", "changefloatingmode", "fullscreen",
+        };
+        std::string name = event.substr(0, event.find(">>"));
+        for (const char* candidate : names) {
+            if (name == candidate) return true;
+        }
+        return false;
+    }
+
+    void run() {
+        refresh();
+        int events_fd = HyprIPC::open_event_stream();
+        if (events_fd < 0) {
+            return; // Outside Hyprland the first snapshot is all there is
+        }
+        std::string pending;
+        std::vector<std::string> events;
+        pollfd fds[2] = {{events_fd, POLLIN, 0}, {wake_fd, POLLIN, 0}};
+        bool dirty = false;
+        auto deadline = std::chrono::steady_clock::now();
+        while (!stopping) {
+            int timeout = -1;
+            if (dirty) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+                timeout = std::max(0, static_cast<int>(left.count()));
+            }
+            int ready = poll(fds, 2, timeout);
+            if (ready < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            if (fds[1].revents) {
+                break; // stop()
+            }
+            if (fds[0].revents) {
+                events.clear();
+                if (!HyprIPC::read_events(events_fd, pending, events)) {
+                    break;
+                }
+                for (const auto& event : events) {
+                    if (!dirty && is_model_event(event)) {
+                        dirty = true;
+                        deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(coalesce_ms);
+                    }
+                }
+            }
+            if (dirty && std::chrono::steady_clock::now() >= deadline) {
+                dirty = false;
+                refresh();
+            }
+        }
+        close(events_fd);
+    }
+
+    std::function<void()> on_publish;
+    Metrics* metrics;
+    SnapshotMailbox mailbox;
+    std::thread thread;
+    std::atomic<bool> stopping{false};
+    int wake_fd = -1;
+    uint64_t version = 0;
+};
@@ -17,6 +17,171 @@
 #include <unordered_map>
 #include <mutex>
 #include <fstream>
+#include "workspace-model.hpp"
+#include "window-search.hpp"
+#include "preview-pyramid.hpp"
+#include "switcher-metrics.hpp"
+#include "window-moves.hpp"
+#include "power-state.hpp"
+#include "theme-engine.hpp"
+#include "preview-index.hpp"
+#include "workspace-contents.hpp"
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <condition_variable>
+#include <deque>
+#include <unordered_set>
+#include <atomic>
+#include <list>
+
+// Command line options
+struct SwitcherOptions {
+    size_t cache_budget_bytes = 32 * 1024 * 1024; // --cache-budget=MB
+    // --preview=auto|capture|minimap: recorder screenshots, window-layout minimaps drawn
+    // from IPC geometry, or a screenshot when one exists and the minimap until then
+    enum PreviewMode { PREVIEW_AUTO, PREVIEW_CAPTURE, PREVIEW_MINIMAP } preview_mode = PREVIEW_AUTO;
+    bool live_thumbnails = false; // --live-thumbnails: ring buttons show their workspace's latest capture
+    std::string metrics_path;     // --metrics=PATH: JSON dump written on exit, empty to disable
+    // --power=auto|low|normal: low stops infinite animations, caps the fade rate and skips
+    // speculative decoding; auto picks it on battery or a low-power platform profile
+    enum PowerMode { POWER_AUTO, POWER_LOW, POWER_NORMAL } power_mode = POWER_AUTO;
+    bool exit_on_first_frame = false; // --exit-on-first-frame: quit once drawn, for startup benchmarks
+    // --verbose: prefetch, cache and wakeup stats on stderr at exit (always in the metrics)
+    // and the theme picked on each reload
+    bool verbose = false;
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+};
+
+// Single memory-budgeted store for every decoded image the switcher keeps.
+// Images are held as cairo image surfaces that all widgets showing them share,
+// so pixel memory scales with distinct images rather than with widgets.
+// Each entry is charged stride x height bytes; once the budget is exceeded the
+// least recently used entries are evicted. Failed loads are cached as zero-byte
+// entries so they are not retried. Safe to use from the tooltip worker thread.
+class ImageCache {
+public:
+    enum Category { WORKSPACE_ICON, APP_ICON, THUMBNAIL, CATEGORY_COUNT };
+
+    explicit ImageCache(size_t budget_bytes) : budget(budget_bytes) {}
+    ~ImageCache() { clear(); }
+
+    // Returns true if the key is cached; *surface receives a new reference (nullptr for a cached failure)
+    bool lookup(Category category, const std::string& key, cairo_surface_t** surface) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index[category].find(key);
+        if (it == index[category].end()) {
+            stats[category].misses++;
+            *surface = nullptr;
+            return false;
+        }
+        stats[category].hits++;
+        lru.splice(lru.begin(), lru, it->second);
+        *surface = it->second->surface ? cairo_surface_reference(it->second->surface) : nullptr;
+        return true;
+    }
+
+    // Presence check that neither counts as a hit nor refreshes the entry
+    bool contains(Category category, const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return index[category].count(key) > 0;
+    }
+
+    // Takes its own reference; surface may be nullptr to remember a failed load
+    void insert(Category category, const std::string& key, cairo_surface_t* surface) {
+        size_t bytes = surface ? surface_bytes(surface) : 0;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index[category].find(key);
+        if (it != index[category].end()) {
+            erase(it->second);
+        }
+        if (bytes > budget) {
+            return; // Would evict everything else and still not fit
+        }
+        lru.push_front(Entry{category, key, surface ? cairo_surface_reference(surface) : nullptr, bytes});
+        index[category][key] = lru.begin();
+        stats[category].bytes += bytes;
+        stats[category].entries++;
+        resident += bytes;
+        peak_resident = std::max(peak_resident, resident);
+        while (resident > budget && !lru.empty()) {
+            stats[lru.back().category].evictions++;
+            erase(std::prev(lru.end()));
+        }
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!lru.empty()) {
+            erase(lru.begin());
+        }
+    }
+
+    void report(std::ostream& out) {
+        static const char* names[CATEGORY_COUNT] = {"workspace icons", "app icons", "thumbnails"};
+        std::lock_guard<std::mutex> lock(mutex);
+        out << "Cache: " << resident / 1024 << " KiB resident (peak " << peak_resident / 1024 << " KiB) of "
+            << budget / 1024 << " KiB budget" << std::endl;
+        for (int c = 0; c < CATEGORY_COUNT; c++) {
+            const CategoryStats& st = stats[c];
+            size_t lookups = st.hits + st.misses;
+            out << "  " << names[c] << ": " << st.entries << " entries, " << st.bytes / 1024 << " KiB, "
+                << st.hits << "/" << lookups << " hits (" << (lookups ? st.hits * 100 / lookups : 0) << "%), "
+                << st.evictions << " evicted" << std::endl;
+        }
+    }
+
+    void export_metrics(Metrics& metrics) {
+        static const char* names[CATEGORY_COUNT] = {"workspace_icons", "app_icons", "thumbnails"};
+        std::lock_guard<std::mutex> lock(mutex);
+        metrics.set("cache.resident_bytes", resident);
+        metrics.set("cache.peak_resident_bytes", peak_resident);
+        for (int c = 0; c < CATEGORY_COUNT; c++) {
+            std::string prefix = std::string("cache.") + names[c] + ".";
+            metrics.set(prefix + "hits", stats[c].hits);
+            metrics.set(prefix + "misses", stats[c].misses);
+            metrics.set(prefix + "evictions", stats[c].evictions);
+            metrics.set(prefix + "entries", stats[c].entries);
+        }
+    }
+
+    static size_t surface_bytes(cairo_surface_t* surface) {
+        return static_cast<size_t>(cairo_image_surface_get_stride(surface)) * cairo_image_surface_get_height(surface);
+    }
+
+private:
+    struct Entry {
+        Category category;
+        std::string key;
+        cairo_surface_t* surface;
+        size_t bytes;
+    };
+    struct CategoryStats {
+        size_t bytes = 0;
+        size_t entries = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+    };
+
+    void erase(std::list<Entry>::iterator entry) {
+        CategoryStats& st = stats[entry->category];
+        st.bytes -= entry->bytes;
+        st.entries--;
+        resident -= entry->bytes;
+        if (entry->surface) cairo_surface_destroy(entry->surface);
+        index[entry->category].erase(entry->key);
+        lru.erase(entry);
+    }
+
+    size_t budget;
+    size_t resident = 0;
+    size_t peak_resident = 0;
+    std::list<Entry> lru; // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index[CATEGORY_COUNT];
+    CategoryStats stats[CATEGORY_COUNT];
+    std::mutex mutex;
+};
 
 class WorkspaceSwitcher {
 private:
@@ -25,19 +190,95 @@ private:
     GtkWidget* tooltip_window;
     GtkWidget* tooltip_label;
     GtkWidget* tooltip_image;
-    // Performance optimization: Cache pixbufs and app data
-    std::unordered_map<int, GdkPixbuf*> workspace_icon_cache;
-    std::unordered_map<int, std::vector<GdkPixbuf*>> app_icon_cache;
-    std::unordered_map<std::string, GdkPixbuf*> theme_icon_cache;
-    std::unordered_map<int, std::vector<std::string>> workspace_apps_cache;
-    std::unordered_map<int, std::vector<GtkWidget*>> app_icon_widgets;
-    std::unordered_map<int, std::vector<std::string>> workspace_app_classes;
-    std::unordered_map<int, GtkWidget*> workspace_buttons; // Track buttons for icon updates
-    std::mutex cache_mutex;
+    // Counters and latency histograms, served on the control socket and dumped on exit.
+    // Declared before everything that records into it.
+    Metrics metrics;
+    std::chrono::steady_clock::time_point started;
+    std::string metrics_path;
+    gulong first_frame_handler = 0;
+    std::chrono::steady_clock::time_point input_time; // Last key press or click
+    bool input_from_key = false;
+    int control_fd = -1;
+    guint control_source_id = 0;
+    std::string control_path;
+    // Performance optimization: Cache image surfaces
+    ImageCache image_cache;
+    // Per-workspace state indexed by UI slot: 1-12 are the numbered workspaces, 13 is
+    // special:elysia in the center, and 14+ are whatever else the compositor reports
+    // (named workspaces, numbers above 12, other specials) in order of discovery.
+    // Slots are never reused, so a slot always means the same workspace.
+    static constexpr int numbered_workspace_count = 12;
+    static constexpr int special_slot = 13;
+    struct WorkspaceView {
+        int hypr_id = 0;   // Compositor id; special:elysia is matched by name instead
+        std::string name;
+        GtkWidget* button = nullptr; // Widgets exist only while the slot is visible
+        std::vector<GtkWidget*> app_icons;
+        // Row saved by the last launch, shown until the first snapshot; restored_hash is 0 without one
+        std::vector<std::pair<std::string, uint32_t>> restored_classes;
+        uint64_t restored_hash = 0;
+        bool row_stale = false; // Row shows restored classes the compositor has not confirmed yet
+    };
+    std::vector<WorkspaceView> views;
+    // Ring virtualization: ring_slots is everything on the ring, split into pages
+    // of ring_page_size. Only the current page gets widgets and icon loads.
+    std::vector<int> ring_slots;
+    std::vector<int> shown_ring_slots;
+    int ring_page = 0;
+    int ring_page_size = numbered_workspace_count;
+    GtkWidget* page_label = nullptr;
+    // Type-to-search: letters start it, the index is rebuilt whenever the snapshot changes
+    WindowSearch window_search;
+    bool search_active = false;
+    std::string search_query;
+    std::vector<uint32_t> search_results; // Window indices into snapshot, best first
+    std::unordered_set<int> search_match_slots;
+    GtkWidget* search_label = nullptr;
+    std::deque<int> pending_icon_slots; // Workspace icons still to load for the visible slots
+    // Per-workspace rendering bounds, independent of how many windows a workspace holds
+    static constexpr int max_row_items = 4;
+    static constexpr size_t max_tooltip_titles = 12;
+    static constexpr size_t max_title_chars = 60;
+    // Window state: the IPC thread publishes snapshots, the UI diffs each one against
+    // the snapshot it currently shows. snapshot is UI thread only.
+    WorkspaceModel model;
+    std::unique_ptr<const WorkspaceSnapshot> snapshot;
+    // Thumbnails decoded by the prefetcher and not yet shown
+    std::unordered_set<int> prefetched_workspaces;
+    // Tooltip worker: one background thread so thumbnail decode never runs on the UI thread.
+    // Jobs with a non-zero generation belong to a hover and die when the pointer leaves.
+    struct TooltipJob {
+        int workspace_id;
+        guint64 generation; // 0 = prefetch
+        // Resolved on the UI thread, which owns views
+        std::string screenshot_path;
+        std::string level_path; // Tooltip-sized pyramid level, preferred when the recorder made one
+        std::string version;    // Capture generation or file time, part of the cache key
+        int scale;
+    };
+    std::thread tooltip_thread;
+    std::mutex tooltip_job_mutex;
+    std::condition_variable tooltip_job_cv;
+    std::deque<TooltipJob> tooltip_jobs;
+    std::unordered_set<int> tooltip_jobs_pending; // Queued or in flight (UI thread only)
+    bool tooltip_thread_stop = false;
+    std::atomic<guint64> tooltip_generation{0};
+    int hovered_workspace = 0;
+    gint tooltip_anchor_x = 0;
+    gint tooltip_anchor_y = 0;
+    // Pointer trajectory (overlay coordinates, velocity in px/ms)
+    double pointer_x = -1.0;
+    double pointer_y = -1.0;
+    guint32 pointer_time = 0;
+    double pointer_vx = 0.0;
+    double pointer_vy = 0.0;
+    // Prefetch accounting, reported on exit
+    int prefetch_issued = 0;
+    int prefetch_hits = 0;
+    int tooltip_requests = 0;
     // Animation and loading state
     bool fade_in_complete = false;
     guint fade_timeout_id = 0;
-    guint app_icon_loader_id = 0;
     guint workspace_icon_loader_id = 0; // For async workspace icon loading
     // Dynamic screen dimensions
     int screen_width;
@@ -49,7 +290,29 @@ private:
     int icon_size;
     int app_icon_size;
     int special_button_size; // Size for workspace 13
+    // Monitor scale: images are decoded at logical size x scale so nothing gets upscaled.
+    // Read by the tooltip worker when it decodes thumbnails.
+    std::atomic<int> scale_factor{1};
     std::string workspace_icon_path; // Theme-specific workspace icon path
+    ThemeEngine::Resolved theme;
+    GtkCssProvider* full_css_provider = nullptr;
+    int theme_watch_fd = -1;
+    guint theme_watch_id = 0;
+    // Recorder's preview index: capture generations read from shared memory, so a cached
+    // thumbnail is checked without touching the files. Watched for new captures.
+    PreviewIndex preview_index;
+    uint64_t preview_index_generation = 0;
+    int preview_watch_fd = -1;
+    guint preview_watch_id = 0;
+    SwitcherOptions::PreviewMode preview_mode;
+    bool live_thumbnails;
+    bool exit_on_first_frame;
+    bool verbose;
+    bool low_power;
+    int fade_interval_ms;
+    // Every main loop poll is a wakeup; counted through the default context's poll function
+    static GPollFunc default_poll_func;
+    static uint64_t main_loop_wakeups;
 
     // Static callbacks
     static gboolean on_button_enter_static(GtkWidget* button, GdkEventCrossing* event, gpointer user_data);
@@ -58,8 +321,21 @@ private:
     static gboolean on_key_press_static(GtkWidget* widget, GdkEventKey* event, gpointer user_data);
     static void     on_destroy_static(GtkWidget* widget, gpointer user_data);
     static gboolean fade_in_timeout_static(gpointer user_data);
-    static gboolean load_app_icons_async_static(gpointer user_data);
+    static gboolean on_snapshot_ready_static(gpointer user_data);
     static gboolean load_workspace_icons_async_static(gpointer user_data);
+    static gboolean on_motion_notify_static(GtkWidget* widget, GdkEventMotion* event, gpointer user_data);
+    static gboolean on_scroll_static(GtkWidget* widget, GdkEventScroll* event, gpointer user_data);
+    static gboolean on_tooltip_result_static(gpointer user_data);
+    static void     on_scale_factor_changed_static(GObject* object, GParamSpec* pspec, gpointer user_data);
+    static gboolean on_first_draw_static(GtkWidget* widget, cairo_t* cr, gpointer user_data);
+    static void     on_drag_begin_static(GtkWidget* widget, GdkDragContext* context, gpointer user_data);
+    static void     on_drag_data_get_static(GtkWidget* widget, GdkDragContext* context, GtkSelectionData* data,
+                                            guint info, guint time, gpointer user_data);
+    static void     on_drag_data_received_static(GtkWidget* widget, GdkDragContext* context, gint x, gint y,
+                                                 GtkSelectionData* data, guint info, guint time, gpointer user_data);
+    static gboolean on_control_ready_static(gint fd, GIOCondition condition, gpointer user_data);
+    static gboolean on_theme_changed_static(gint fd, GIOCondition condition, gpointer user_data);
+    static gboolean on_preview_index_changed_static(gint fd, GIOCondition condition, gpointer user_data);
 
     void calculate_dimensions() {
         GdkScreen* screen = gdk_screen_get_default();
@@ -71,62 +347,74 @@ private:
         int min_dimension = std::min(screen_width, screen_height);
         radius = std::max(200, static_cast<int>(min_dimension * 0.40));
         // Scale button and icon sizes based on screen size
-        button_size = std::max(120, static_cast<int>(min_dimension * 0.08));
-        icon_size = std::max(50, static_cast<int>(button_size * 0.83));
+        button_size = PreviewPyramid::button_size(screen_width, screen_height);
+        icon_size = PreviewPyramid::icon_size(button_size);
         app_icon_size = std::max(16, static_cast<int>(button_size * 0.17));
         // --- CHANGE: Make workspace 13 button 2x the size ---
         // special_button_size = static_cast<int>(button_size * 1.5); // Old size
         special_button_size = button_size * 2; // New size: 2x regular button size
         // --- END CHANGE ---
+        // As many ring buttons as fit the circumference with a little air between them
+        ring_page_size = std::max(numbered_workspace_count, static_cast<int>(2 * M_PI * radius / (button_size * 1.15)));
+        // GTK3 reports integer scales; fractional outputs get the next integer and the compositor downsamples
+        GdkDisplay* display = gdk_display_get_default();
+        GdkMonitor* monitor = gdk_display_get_primary_monitor(display);
+        if (!monitor) {
+            monitor = gdk_display_get_monitor(display, 0);
+        }
+        scale_factor = monitor ? std::max(1, gdk_monitor_get_scale_factor(monitor)) : 1;
     }
 
-    std::string determine_workspace_icon_path() {
-        std::string home_dir = getenv("HOME") ? getenv("HOME") : "";
-        std::string light_txt_path = home_dir + "/.config/hypr/Light.txt";
-        
-        // Default to Theme 1 (current/ely theme)
-        std::string default_path = home_dir + "/.config/Elysia/assets/workspace/";
-        
-        // Check if Light.txt exists
-        if (!std::filesystem::exists(light_txt_path)) {
-            return default_path;
-        }
-        
-        // Read the file content
-        std::ifstream file(light_txt_path);
-        if (!file.is_open()) {
-            return default_path;
-        }
-        
-        std::string content;
-        std::string line;
-        while (std::getline(file, line)) {
-            content += line;
-        }
-        file.close();
-        
-        // Check for "cyrene" theme
-        if (content.find("cyrene") != std::string::npos) {
-            // Theme 2: cyrene
-            return home_dir + "/.config/Elysia/assets/workspace/AMPH/";
-        }
-        
-        // Check for "ely" theme or default to Theme 1
-        if (content.find("ely") != std::string::npos) {
-            // Theme 1: ely (current theme)
-            return default_path;
-        }
-        
-        // If file exists but doesn't contain either keyword, default to Theme 1
-        return default_path;
+    // Cache key suffix: the same image at another size or scale is a different decode
+    static std::string size_key(int logical_size, int scale) {
+        return "@" + std::to_string(logical_size) + "x" + std::to_string(scale);
+    }
+
+    static std::string theme_file_path() {
+        return ThemeEngine::expand_home("~/.config/Elysia/workspace-themes.ini");
+    }
+
+    // Written by the ElysiaOS theme switcher; its content picks the theme
+    static std::string theme_selector_path() {
+        return ThemeEngine::expand_home("~/.config/hypr/Light.txt");
+    }
+
+    static std::string cache_dir() {
+        const char* cache_home = getenv("XDG_CACHE_HOME");
+        std::string dir = cache_home && *cache_home ? cache_home : ThemeEngine::expand_home("~/.cache");
+        return dir + "/ely-workspace-switcher";
+    }
+
+    static std::string theme_cache_path() {
+        return cache_dir() + "/theme.css";
+    }
+
+    static std::string contents_cache_path() {
+        return cache_dir() + "/contents.bin";
+    }
+
+    void load_theme() {
+        theme = ThemeEngine::resolve(theme_file_path(), theme_selector_path(), theme_cache_path());
+        workspace_icon_path = theme.icon_dir;
     }
 
 public:
-    WorkspaceSwitcher() {
+    explicit WorkspaceSwitcher(const SwitcherOptions& options)
+        : started(options.started),
+          metrics_path(options.metrics_path),
+          image_cache(options.cache_budget_bytes),
+          model([this] { g_idle_add_full(G_PRIORITY_LOW, on_snapshot_ready_static, this, nullptr); }, &metrics),
+          preview_mode(options.preview_mode),
+          live_thumbnails(options.live_thumbnails),
+          exit_on_first_frame(options.exit_on_first_frame),
+          verbose(options.verbose),
+          low_power(options.power_mode == SwitcherOptions::POWER_LOW),
+          fade_interval_ms(low_power ? 33 : 8) {
         // Minimal startup - just show the window ASAP
         calculate_dimensions();
+        init_workspace_slots();
         // Determine workspace icon path based on theme
-        workspace_icon_path = determine_workspace_icon_path();
+        load_theme();
         create_window();
         setup_layer_shell();
         // Create buttons immediately but without icons (fastest)
@@ -134,14 +422,25 @@ public:
         // Apply minimal CSS first
         apply_minimal_css();
         connect_signals();
+        count_wakeups();
+        first_frame_handler = g_signal_connect(window, "draw", G_CALLBACK(WorkspaceSwitcher::on_first_draw_static), this);
         // Show UI immediately - this is the key to fast startup
         gtk_widget_show_all(window);
         gtk_widget_grab_focus(window);
         // Start everything else asynchronously after UI is visible
         start_fade_in_animation();
         // Defer all heavy operations with different priorities
-        workspace_icon_loader_id = g_idle_add_full(G_PRIORITY_HIGH, load_workspace_icons_async_static, this, nullptr);
-        app_icon_loader_id = g_idle_add_full(G_PRIORITY_LOW, load_app_icons_async_static, this, nullptr);
+        queue_workspace_icons();
+        // App icon rows follow the first snapshot from the IPC thread; until then the
+        // last launch's rows stand in, at a priority that runs ahead of the snapshot
+        g_idle_add_full(G_PRIORITY_DEFAULT_IDLE, [](gpointer user_data) -> gboolean {
+            static_cast<WorkspaceSwitcher*>(user_data)->restore_app_rows();
+            return FALSE; // Run once
+        }, this, nullptr);
+        model.start();
+        start_control_socket();
+        start_theme_watch();
+        start_preview_watch();
         // Defer tooltip creation and full CSS loading
         g_idle_add_full(G_PRIORITY_LOW, [](gpointer user_data) -> gboolean {
             WorkspaceSwitcher* self = static_cast<WorkspaceSwitcher*>(user_data);
@@ -152,74 +451,248 @@ public:
     }
 
     ~WorkspaceSwitcher() {
+        report_wakeups();
+        model.stop();
+        stop_tooltip_worker();
+        stop_control_socket();
+        stop_theme_watch();
+        stop_preview_watch();
+        save_app_rows();
+        report_prefetch_stats();
+        if (verbose) {
+            image_cache.report(std::cerr);
+        }
+        write_metrics_file();
         cleanup_caches();
         if (fade_timeout_id > 0) {
             g_source_remove(fade_timeout_id);
         }
-        if (app_icon_loader_id > 0) {
-            g_source_remove(app_icon_loader_id);
-        }
         if (workspace_icon_loader_id > 0) {
             g_source_remove(workspace_icon_loader_id);
         }
     }
 
     void cleanup_caches() {
-        std::lock_guard<std::mutex> lock(cache_mutex);
-        for (auto& pair : workspace_icon_cache) {
-            if (pair.second) g_object_unref(pair.second);
+        image_cache.clear();
+    }
+
+    // Numbers kept elsewhere are copied in whenever metrics are read
+    void write_metrics_json(std::ostream& out) {
+        image_cache.export_metrics(metrics);
+        metrics.set("prefetch.issued", prefetch_issued);
+        metrics.set("prefetch.hits", prefetch_hits);
+        metrics.set("tooltip.requests", tooltip_requests);
+        metrics.set("workspaces", ring_slots.size() + 1);
+        metrics.set("power.low_power", low_power);
+        metrics.set("main_loop.wakeups", main_loop_wakeups);
+        metrics.set("main_loop.wakeups_per_s", static_cast<uint64_t>(wakeups_per_second()));
+        metrics.write_json(out);
+    }
+
+    void write_metrics_file() {
+        if (metrics_path.empty()) {
+            return;
         }
-        workspace_icon_cache.clear();
-        for (auto& pair : app_icon_cache) {
-            for (auto* pixbuf : pair.second) {
-                if (pixbuf) g_object_unref(pixbuf);
-            }
+        std::ofstream file(metrics_path, std::ios::trunc);
+        if (!file) {
+            std::cerr << "Error writing metrics to " << metrics_path << std::endl;
+            return;
         }
-        app_icon_cache.clear();
-        for (auto& pair : theme_icon_cache) {
-            if (pair.second) g_object_unref(pair.second);
+        write_metrics_json(file);
+        file << std::endl;
+    }
+
+    static gint counting_poll(GPollFD* fds, guint nfds, gint timeout) {
+        main_loop_wakeups++;
+        return default_poll_func(fds, nfds, timeout);
+    }
+
+    void count_wakeups() {
+        default_poll_func = g_main_context_get_poll_func(nullptr);
+        g_main_context_set_poll_func(nullptr, counting_poll);
+    }
+
+    double wakeups_per_second() const {
+        double seconds = Metrics::elapsed_ms(started) / 1000.0;
+        return seconds > 0 ? main_loop_wakeups / seconds : 0.0;
+    }
+
+    void report_wakeups() {
+        if (!verbose) {
+            return;
+        }
+        std::cerr << "Main loop: " << main_loop_wakeups << " wakeups, " << static_cast<int>(wakeups_per_second())
+                  << "/s" << (low_power ? " (low-power)" : "") << std::endl;
+    }
+
+    void on_first_draw() {
+        metrics.observe("open_to_first_frame", Metrics::elapsed_ms(started));
+        g_signal_handler_disconnect(window, first_frame_handler);
+        first_frame_handler = 0;
+        if (exit_on_first_frame) {
+            gtk_main_quit(); // The frame is still committed; the loop exits after this dispatch
+        }
+    }
+
+    void record_dispatch() {
+        metrics.count("dispatches");
+        metrics.observe(input_from_key ? "key_to_dispatch" : "click_to_dispatch", Metrics::elapsed_ms(input_time));
+    }
+
+    static std::string get_control_socket_path() {
+        const char* runtime_dir = getenv("XDG_RUNTIME_DIR");
+        if (runtime_dir && *runtime_dir) {
+            return std::string(runtime_dir) + "/ely-workspace-switcher.sock";
+        }
+        return "/tmp/ely-workspace-switcher-" + std::to_string(getuid()) + ".sock";
+    }
+
+    // Control socket: one line command per connection, answered on the main loop.
+    // `echo stats | socat - UNIX-CONNECT:$XDG_RUNTIME_DIR/ely-workspace-switcher.sock`
+    void start_control_socket() {
+        control_path = get_control_socket_path();
+        sockaddr_un addr = {};
+        if (control_path.size() >= sizeof(addr.sun_path)) {
+            return;
+        }
+        control_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+        if (control_fd < 0) {
+            return;
+        }
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, control_path.c_str(), control_path.size() + 1);
+        unlink(control_path.c_str()); // Left behind by a previous instance that crashed
+        if (bind(control_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(control_fd, 4) < 0) {
+            std::cerr << "Control socket unavailable: " << control_path << std::endl;
+            close(control_fd);
+            control_fd = -1;
+            return;
+        }
+        control_source_id = g_unix_fd_add(control_fd, G_IO_IN, on_control_ready_static, this);
+    }
+
+    void stop_control_socket() {
+        if (control_source_id > 0) {
+            g_source_remove(control_source_id);
+            control_source_id = 0;
+        }
+        if (control_fd >= 0) {
+            close(control_fd);
+            control_fd = -1;
+            unlink(control_path.c_str());
+        }
+    }
+
+    void on_control_ready() {
+        int client = accept4(control_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            return;
+        }
+        // A client that never sends its command must not stall the UI
+        timeval timeout = {0, 100 * 1000};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        char buffer[128];
+        ssize_t n = read(client, buffer, sizeof(buffer) - 1);
+        std::string command = n > 0 ? std::string(buffer, static_cast<size_t>(n)) : "";
+        command.erase(command.find_last_not_of(" \r\n") + 1);
+        std::ostringstream reply;
+        if (command == "stats") {
+            write_metrics_json(reply);
+        } else {
+            reply << "error: unknown command '" << command << "' (try: stats)";
+        }
+        reply << "\n";
+        std::string text = reply.str();
+        ssize_t written = write(client, text.data(), text.size());
+        (void)written;
+        close(client);
+    }
+
+    // Async workspace icon loading, for the visible slots only
+    void queue_workspace_icons() {
+        pending_icon_slots.assign(shown_ring_slots.begin(), shown_ring_slots.end());
+        pending_icon_slots.push_front(special_slot);
+        if (workspace_icon_loader_id == 0) {
+            workspace_icon_loader_id = g_idle_add_full(G_PRIORITY_HIGH, load_workspace_icons_async_static, this, nullptr);
         }
-        theme_icon_cache.clear();
     }
 
-    // Async workspace icon loading
     gboolean load_workspace_icons_async() {
-        static int current_workspace = 1;
-        if (current_workspace > 13) {
+        if (pending_icon_slots.empty()) {
             workspace_icon_loader_id = 0;
             return FALSE; // Stop the idle callback
         }
         // Load one workspace icon at a time
-        load_workspace_icon(current_workspace);
-        current_workspace++;
+        int slot = pending_icon_slots.front();
+        pending_icon_slots.pop_front();
+        load_workspace_icon(slot);
         return TRUE; // Continue for next workspace
     }
 
-    void load_workspace_icon(int workspace_id) {
-        std::string image_path = workspace_icon_path + std::to_string(workspace_id) + ".png";
-        if (!std::filesystem::exists(image_path)) {
+    // Theme icon for a slot: N.png for the fixed slots and numbered extras, none for named ones
+    std::string workspace_icon_file(int slot) const {
+        int number = slot <= special_slot ? slot : views[slot].hypr_id;
+        return number > 0 ? workspace_icon_path + std::to_string(number) + ".png" : "";
+    }
+
+    // Live thumbnails use the pyramid level made for the button, keyed by its capture
+    // version so a new capture is picked up; the theme icon stands in where none exists yet
+    void load_workspace_icon(int workspace_id, bool use_capture = true) {
+        if (!view(workspace_id).button) {
+            return; // Off-page; loaded again when its page is shown
+        }
+        std::string image_path;
+        std::string version;
+        if (live_thumbnails && use_capture) {
+            std::string level = get_preview_level_path(
+                workspace_id, workspace_id == special_slot ? PreviewPyramid::CENTER : PreviewPyramid::BUTTON, scale_factor);
+            version = preview_version(workspace_id, level);
+            if (!version.empty()) {
+                image_path = level;
+            }
+        }
+        bool native = !image_path.empty(); // Pyramid levels are already at display size
+        if (!native) {
+            image_path = workspace_icon_file(workspace_id);
+            version.clear();
+        }
+        if (image_path.empty() || (!native && !std::filesystem::exists(image_path))) {
             return; // Skip if file doesn't exist
         }
         GError* error = nullptr;
         int current_icon_size;
         // --- CHANGE: Adjust icon size for workspace 13 to better fit the larger button ---
-        if (workspace_id == 13) {
+        if (workspace_id == special_slot) {
             // current_icon_size = static_cast<int>(icon_size * 1.5); // Old size
-            current_icon_size = static_cast<int>(icon_size * 1.8); // New size: 1.8x base icon size
+            current_icon_size = PreviewPyramid::center_icon_size(icon_size); // New size: 1.8x base icon size
         } else {
             current_icon_size = icon_size;
         }
         // --- END CHANGE ---
-        GdkPixbuf* pixbuf = gdk_pixbuf_new_from_file_at_size(image_path.c_str(), current_icon_size, current_icon_size, &error);
-        if (error) {
-            g_error_free(error);
+        int scale = scale_factor;
+        std::string cache_key = image_path + size_key(current_icon_size, scale) + version;
+        cairo_surface_t* surface = nullptr;
+        if (!image_cache.lookup(ImageCache::WORKSPACE_ICON, cache_key, &surface)) {
+            Metrics::Timer timer(metrics, "decode_workspace_icon");
+            GdkPixbuf* pixbuf = native ? gdk_pixbuf_new_from_file(image_path.c_str(), &error)
+                                       : gdk_pixbuf_new_from_file_at_size(image_path.c_str(), current_icon_size * scale,
+                                                                          current_icon_size * scale, &error);
+            if (error) {
+                g_error_free(error);
+                pixbuf = nullptr;
+            }
+            surface = surface_from_pixbuf(pixbuf, scale);
+            image_cache.insert(ImageCache::WORKSPACE_ICON, cache_key, surface); // Failures too, so they are not retried
+        }
+        if (!surface && native) {
+            load_workspace_icon(workspace_id, false); // Captures published without a pyramid have no level
             return;
         }
-        if (pixbuf) {
+        if (surface) {
             // Update the button with the icon
-            auto button_it = workspace_buttons.find(workspace_id);
-            if (button_it != workspace_buttons.end()) {
-                GtkWidget* button = button_it->second;
+            GtkWidget* button = view(workspace_id).button;
+            if (button) {
                 // Remove existing label if any
                 GList* children = gtk_container_get_children(GTK_CONTAINER(button));
                 if (children) {
@@ -227,82 +700,368 @@ public:
                     g_list_free(children);
                 }
                 // Add image
-                GtkWidget* image = gtk_image_new_from_pixbuf(pixbuf);
+                GtkWidget* image = gtk_image_new_from_surface(surface);
                 GtkStyleContext* img_context = gtk_widget_get_style_context(image);
-                gtk_style_context_add_class(img_context, "workspace-icon");
+                gtk_style_context_add_class(img_context, native ? "workspace-live" : "workspace-icon");
                 gtk_container_add(GTK_CONTAINER(button), image);
                 gtk_widget_show(image);
             }
-            // Cache the result
-            {
-                std::lock_guard<std::mutex> lock(cache_mutex);
-                workspace_icon_cache[workspace_id] = pixbuf;
+            cairo_surface_destroy(surface);
+        }
+    }
+
+    WorkspaceView& view(int slot) {
+        return views[slot];
+    }
+
+    const WorkspaceView& view(int slot) const {
+        return views[slot];
+    }
+
+    void init_workspace_slots() {
+        views.resize(special_slot + 1); // Slot 0 is unused
+        for (int slot = 1; slot <= numbered_workspace_count; slot++) {
+            views[slot].hypr_id = slot;
+            views[slot].name = std::to_string(slot);
+            ring_slots.push_back(slot);
+        }
+        views[special_slot].name = "special:elysia";
+    }
+
+    // Slots 1-12 and special:elysia always exist; anything else gets a slot once seen
+    static bool is_fixed_workspace(const WorkspaceSnapshot& from, const WorkspaceRecord& record) {
+        return (record.id >= 1 && record.id <= numbered_workspace_count) || from.str(record.name_id) == "special:elysia";
+    }
+
+    int find_extra_slot(int hypr_id) const {
+        for (size_t slot = special_slot + 1; slot < views.size(); slot++) {
+            if (views[slot].hypr_id == hypr_id) return static_cast<int>(slot);
+        }
+        return 0;
+    }
+
+    // UI slot showing a snapshot record, 0 if none
+    int slot_for_record(const WorkspaceSnapshot& from, const WorkspaceRecord& record) const {
+        if (record.id >= 1 && record.id <= numbered_workspace_count) {
+            return record.id;
+        }
+        if (from.str(record.name_id) == "special:elysia") {
+            return special_slot;
+        }
+        return find_extra_slot(record.id);
+    }
+
+    bool is_extra_special(int slot) const {
+        return slot > special_slot && view(slot).name.rfind("special:", 0) == 0;
+    }
+
+    const WorkspaceRecord* find_record(const WorkspaceSnapshot& from, int slot) const {
+        if (slot == special_slot) {
+            return from.find_by_name("special:elysia");
+        }
+        return from.find(view(slot).hypr_id);
+    }
+
+    const WorkspaceRecord* find_record(int slot) const {
+        return snapshot ? find_record(*snapshot, slot) : nullptr;
+    }
+
+    bool is_slot_visible(int slot) const {
+        return slot == special_slot ||
+               std::find(shown_ring_slots.begin(), shown_ring_slots.end(), slot) != shown_ring_slots.end();
+    }
+
+    // Ring membership follows the compositor: extras appear with their workspace and
+    // leave with it. Numbered extras come first in id order, then named ones, then specials.
+    bool update_ring_slots(const WorkspaceSnapshot& from) {
+        std::vector<int> extras;
+        for (const WorkspaceRecord& record : from.workspaces) {
+            if (is_fixed_workspace(from, record)) {
+                continue;
+            }
+            int slot = find_extra_slot(record.id);
+            if (slot == 0) {
+                slot = static_cast<int>(views.size());
+                views.emplace_back();
+                views[slot].hypr_id = record.id;
             }
+            views[slot].name = from.str(record.name_id);
+            extras.push_back(slot);
         }
+        auto rank = [this](int slot) {
+            int id = view(slot).hypr_id;
+            return std::make_pair(id > 0 ? 0 : (is_extra_special(slot) ? 2 : 1), std::abs(id));
+        };
+        std::sort(extras.begin(), extras.end(), [&rank](int a, int b) { return rank(a) < rank(b); });
+        std::vector<int> next(ring_slots.begin(), ring_slots.begin() + numbered_workspace_count);
+        next.insert(next.end(), extras.begin(), extras.end());
+        if (next == ring_slots) {
+            return false;
+        }
+        ring_slots = std::move(next);
+        return true;
     }
 
-    // Async app icon loading to avoid blocking startup
-    gboolean load_app_icons_async() {
-        static int current_workspace = 1;
-        if (current_workspace > 13) {
-            app_icon_loader_id = 0;
-            return FALSE; // Stop the idle callback
+    // Take the newest snapshot and touch only the workspaces whose contents changed
+    void apply_snapshot() {
+        std::unique_ptr<const WorkspaceSnapshot> next = model.take();
+        if (!next) {
+            return; // An earlier idle already applied it
         }
-        // Load icons for one workspace at a time to spread the work
-        load_workspace_app_icons(current_workspace);
-        current_workspace++;
-        return TRUE; // Continue for next workspace
+        bool first = !snapshot;
+        bool ring_changed = update_ring_slots(*next);
+        // Only visible slots have rows to update; others are built when their page is shown
+        std::vector<int> changed_rows;
+        bool hovered_changed = first;
+        std::vector<int> visible(shown_ring_slots);
+        visible.push_back(special_slot);
+        for (int workspace_id : visible) {
+            const WorkspaceRecord* before = find_record(workspace_id);
+            const WorkspaceRecord* after = find_record(*next, workspace_id);
+            // The first snapshot is diffed against the restored rows
+            uint64_t before_hash = first ? view(workspace_id).restored_hash : (before ? before->classes_hash : 0);
+            if (before_hash != (after ? after->classes_hash : 0)) {
+                changed_rows.push_back(workspace_id);
+            }
+            if (workspace_id == hovered_workspace &&
+                ((before ? before->titles_hash : 0) != (after ? after->titles_hash : 0) ||
+                 (before ? before->layout_hash : 0) != (after ? after->layout_hash : 0))) {
+                hovered_changed = true;
+            }
+        }
+        snapshot = std::move(next);
+        if (ring_changed) {
+            // Positions depend on the item count, so the page is laid out again with fresh rows
+            build_ring_page();
+            changed_rows.erase(std::remove_if(changed_rows.begin(), changed_rows.end(),
+                                              [](int slot) { return slot != special_slot; }),
+                               changed_rows.end());
+        }
+        for (int workspace_id : changed_rows) {
+            load_workspace_app_icons(workspace_id);
+        }
+        if (first) {
+            confirm_restored_rows();
+        }
+        if (hovered_workspace && hovered_changed) {
+            render_tooltip(hovered_workspace);
+        }
+        if (search_active) {
+            update_search(); // Results refer to the old snapshot's windows
+        }
+    }
+
+    // Non-empty values of one window field on a workspace, in compositor order.
+    // At most limit are copied; *total receives how many there are.
+    std::vector<std::string> workspace_strings(int workspace_id, uint32_t WindowEntry::*field,
+                                               size_t limit = SIZE_MAX, size_t* total = nullptr) const {
+        std::vector<std::string> values;
+        size_t count = 0;
+        const WorkspaceRecord* record = find_record(workspace_id);
+        if (record) {
+            for (const WindowEntry* w = snapshot->windows_begin(*record); w != snapshot->windows_end(*record); ++w) {
+                const std::string& value = snapshot->str(w->*field);
+                if (value.empty()) {
+                    continue;
+                }
+                if (count++ < limit) {
+                    values.push_back(value);
+                }
+            }
+        }
+        if (total) {
+            *total = count;
+        }
+        return values;
     }
 
+    bool workspace_has_windows(int workspace_id) const {
+        const WorkspaceRecord* record = find_record(workspace_id);
+        return record && record->window_count > 0;
+    }
+
+    // One icon per distinct class with a window count badge, and a "+N" badge once
+    // there are more classes than fit, so a row never exceeds max_row_items entries.
+    // Before the first snapshot the row comes from the last launch and is marked stale.
     void load_workspace_app_icons(int workspace_id) {
-        std::vector<std::string> app_classes = get_workspace_app_classes(workspace_id);
-        if (app_classes.empty()) {
+        WorkspaceView& workspace_view = view(workspace_id);
+        for (GtkWidget* widget : workspace_view.app_icons) {
+            gtk_widget_destroy(widget);
+        }
+        workspace_view.app_icons.clear();
+        workspace_view.row_stale = false;
+        if (!workspace_view.button) {
+            return; // Off-page
+        }
+        std::vector<std::pair<std::string, uint32_t>> classes;
+        const WorkspaceRecord* record = find_record(workspace_id);
+        if (record) {
+            for (const std::pair<uint32_t, uint32_t>& counted : snapshot->class_counts(*record)) {
+                classes.emplace_back(snapshot->str(counted.first), counted.second);
+            }
+        } else if (!snapshot) {
+            classes = workspace_view.restored_classes;
+            workspace_view.row_stale = !classes.empty();
+        }
+        if (classes.empty()) {
             return;
         }
-        std::vector<GdkPixbuf*> workspace_app_icons;
-        std::vector<GtkWidget*> workspace_icon_widgets;
+        bool stale = workspace_view.row_stale;
         int base_x, base_y;
-        if (workspace_id == 13) {
+        get_workspace_center(workspace_id, base_x, base_y);
+        if (workspace_id == special_slot) {
             // Special positioning for center workspace - place app icons below the button
-            base_x = center_x;
             base_y = center_y + special_button_size/2 + 20;
-        } else {
-            // Calculate base position for regular workspaces
-            double angle = (workspace_id - 1) * (2 * M_PI / 12) - (M_PI / 2);
-            base_x = center_x + radius * cos(angle);
-            base_y = center_y + radius * sin(angle);
         }
-        // Limit to maximum 4 icons to avoid overcrowding
-        int max_icons = std::min(4, static_cast<int>(app_classes.size()));
+        // Limit to maximum 4 entries to avoid overcrowding; the last one becomes "+N" on overflow
+        int row_items = std::min(max_row_items, static_cast<int>(classes.size()));
+        int shown_icons = static_cast<int>(classes.size()) > max_row_items ? max_row_items - 1 : row_items;
         int icon_spacing = std::max(20, app_icon_size + 5);
-        int start_offset = -(max_icons - 1) * icon_spacing / 2;
-        for (int j = 0; j < max_icons; j++) {
-            GdkPixbuf* app_icon = get_app_icon(app_classes[j]);
-            if (app_icon) {
-                int icon_x = base_x + start_offset + (j * icon_spacing) - app_icon_size/2;
-                int icon_y;
-                if (workspace_id == 13) {
-                    // For center workspace, place icons directly below
-                    icon_y = base_y;
-                } else {
-                    // For regular workspaces, place icons below the button
-                    icon_y = base_y + button_size/2 + 10;
+        int start_offset = -(row_items - 1) * icon_spacing / 2;
+        int icon_y;
+        if (workspace_id == special_slot) {
+            // For center workspace, place icons directly below
+            icon_y = base_y;
+        } else {
+            // For regular workspaces, place icons below the button
+            icon_y = base_y + button_size/2 + 10;
+        }
+        for (int j = 0; j < shown_icons; j++) {
+            const std::string& app_class = classes[j].first;
+            cairo_surface_t* app_icon = get_app_icon(app_class);
+            if (!app_icon) {
+                continue;
+            }
+            int icon_x = base_x + start_offset + (j * icon_spacing) - app_icon_size/2;
+            // Every occurrence of the same class shares one surface
+            GtkWidget* app_icon_image = gtk_image_new_from_surface(app_icon);
+            GtkStyleContext* icon_context = gtk_widget_get_style_context(app_icon_image);
+            gtk_style_context_add_class(icon_context, "app-icon");
+            if (stale) {
+                gtk_style_context_add_class(icon_context, "app-stale");
+            }
+            // Images have no input window; the box makes the icon draggable onto another workspace
+            GtkWidget* app_icon_box = gtk_event_box_new();
+            gtk_event_box_set_visible_window(GTK_EVENT_BOX(app_icon_box), FALSE);
+            gtk_container_add(GTK_CONTAINER(app_icon_box), app_icon_image);
+            g_object_set_data_full(G_OBJECT(app_icon_box), "app-class", g_strdup(app_class.c_str()), g_free);
+            if (!stale) {
+                make_drag_source(app_icon_box, workspace_id); // Moves need the live windows
+            }
+            gtk_fixed_put(GTK_FIXED(fixed), app_icon_box, icon_x, icon_y);
+            gtk_widget_show_all(app_icon_box);
+            workspace_view.app_icons.push_back(app_icon_box);
+            cairo_surface_destroy(app_icon);
+            if (classes[j].second > 1) {
+                add_row_badge(workspace_view, std::to_string(classes[j].second), "app-count",
+                              icon_x + app_icon_size/2, icon_y + app_icon_size/2);
+            }
+        }
+        if (shown_icons < row_items) {
+            int hidden = static_cast<int>(classes.size()) - shown_icons;
+            int badge_x = base_x + start_offset + (shown_icons * icon_spacing) - app_icon_size/2;
+            add_row_badge(workspace_view, "+" + std::to_string(hidden), "app-overflow", badge_x, icon_y);
+        }
+    }
+
+    void add_row_badge(WorkspaceView& workspace_view, const std::string& text, const char* css_class, int x, int y) {
+        GtkWidget* badge = gtk_label_new(text.c_str());
+        gtk_style_context_add_class(gtk_widget_get_style_context(badge), css_class);
+        if (workspace_view.row_stale) {
+            gtk_style_context_add_class(gtk_widget_get_style_context(badge), "app-stale");
+        }
+        gtk_fixed_put(GTK_FIXED(fixed), badge, x, y);
+        gtk_widget_show(badge);
+        workspace_view.app_icons.push_back(badge);
+    }
+
+    // Lays out the rows saved by the last launch; skipped once a snapshot has arrived
+    void restore_app_rows() {
+        if (snapshot) {
+            return;
+        }
+        int restored = 0;
+        for (WorkspaceContents::Row& row : WorkspaceContents::load(contents_cache_path())) {
+            if (row.slot < 1 || row.slot > special_slot || row.classes.empty()) {
+                continue; // Extra workspaces get their slots from the compositor
+            }
+            WorkspaceView& workspace_view = view(row.slot);
+            workspace_view.restored_classes = std::move(row.classes);
+            workspace_view.restored_hash = row.classes_hash;
+            if (is_slot_visible(row.slot)) {
+                load_workspace_app_icons(row.slot);
+                restored++;
+            }
+        }
+        metrics.count("app_rows.restored", restored);
+    }
+
+    // First snapshot: rows it left alone matched the restored ones, so they only lose the
+    // stale mark and become draggable; the restored data is not needed again
+    void confirm_restored_rows() {
+        int confirmed = 0;
+        for (int slot = 1; slot <= special_slot; slot++) {
+            WorkspaceView& workspace_view = view(slot);
+            if (workspace_view.row_stale) {
+                for (GtkWidget* widget : workspace_view.app_icons) {
+                    GtkWidget* styled = widget;
+                    if (GTK_IS_EVENT_BOX(widget)) {
+                        styled = gtk_bin_get_child(GTK_BIN(widget));
+                        make_drag_source(widget, slot);
+                    }
+                    gtk_style_context_remove_class(gtk_widget_get_style_context(styled), "app-stale");
                 }
-                GtkWidget* app_icon_image = gtk_image_new_from_pixbuf(app_icon);
-                GtkStyleContext* icon_context = gtk_widget_get_style_context(app_icon_image);
-                gtk_style_context_add_class(icon_context, "app-icon");
-                gtk_fixed_put(GTK_FIXED(fixed), app_icon_image, icon_x, icon_y);
-                gtk_widget_show(app_icon_image);
-                workspace_app_icons.push_back(g_object_ref(app_icon));
-                workspace_icon_widgets.push_back(app_icon_image);
-                g_object_unref(app_icon);
+                workspace_view.row_stale = false;
+                confirmed++;
             }
+            workspace_view.restored_classes.clear();
+            workspace_view.restored_hash = 0;
+        }
+        metrics.count("app_rows.confirmed", confirmed);
+    }
+
+    // The fixed workspaces' rows as the compositor last reported them, for the next launch
+    void save_app_rows() {
+        if (!snapshot) {
+            return; // Never heard from the compositor; keep the previous record
         }
-        if (!workspace_app_icons.empty()) {
-            std::lock_guard<std::mutex> lock(cache_mutex);
-            app_icon_cache[workspace_id] = workspace_app_icons;
-            app_icon_widgets[workspace_id] = workspace_icon_widgets;
-            workspace_app_classes[workspace_id] = app_classes;
+        std::vector<WorkspaceContents::Row> rows;
+        for (int slot = 1; slot <= special_slot; slot++) {
+            const WorkspaceRecord* record = find_record(slot);
+            if (!record || record->window_count == 0) {
+                continue;
+            }
+            WorkspaceContents::Row row;
+            row.slot = slot;
+            row.classes_hash = record->classes_hash;
+            for (const std::pair<uint32_t, uint32_t>& counted : snapshot->class_counts(*record)) {
+                row.classes.emplace_back(snapshot->str(counted.first), counted.second);
+            }
+            rows.push_back(std::move(row));
+        }
+        WorkspaceContents::save(contents_cache_path(), rows);
+    }
+
+    // Window moved to an output with a different scale: swap in images decoded for it.
+    // Caches are keyed by scale, so moving back is free.
+    void on_scale_factor_changed() {
+        int scale = std::max(1, gtk_widget_get_scale_factor(window));
+        if (scale == scale_factor) {
+            return;
+        }
+        scale_factor = scale;
+        std::vector<int> visible(shown_ring_slots);
+        visible.push_back(special_slot);
+        for (int workspace_id : visible) {
+            load_workspace_icon(workspace_id);
+            for (GtkWidget* widget : view(workspace_id).app_icons) {
+                const char* app_class = static_cast<const char*>(g_object_get_data(G_OBJECT(widget), "app-class"));
+                cairo_surface_t* app_icon = app_class ? get_app_icon(app_class) : nullptr;
+                if (app_icon) {
+                    gtk_image_set_from_surface(GTK_IMAGE(gtk_bin_get_child(GTK_BIN(widget))), app_icon);
+                    cairo_surface_destroy(app_icon);
+                }
+            }
         }
     }
 
@@ -310,12 +1069,13 @@ public:
         // Set initial opacity to 0
         gtk_widget_set_opacity(window, 0.0);
         // Start fade-in timer with higher frequency for smoother animation
-        fade_timeout_id = g_timeout_add(8, fade_in_timeout_static, this); // ~120fps for ultra smooth
+        // ~120fps for ultra smooth, ~30fps in low-power mode over the same duration
+        fade_timeout_id = g_timeout_add(fade_interval_ms, fade_in_timeout_static, this);
     }
 
     gboolean fade_in_timeout() {
         static double opacity = 0.0;
-        opacity += 0.12; // Even faster fade for instant responsiveness
+        opacity += 0.12 * fade_interval_ms / 8; // Even faster fade for instant responsiveness
         if (opacity >= 1.0) {
             opacity = 1.0;
             fade_in_complete = true;
@@ -328,18 +1088,99 @@ public:
         return TRUE; // Continue animation
     }
 
-    static std::string get_screenshot_path(int workspace_id) {
-        return std::string("/tmp/workspace_previews/workspace_") + std::to_string(workspace_id) + ".png";
+    // The recorder names previews by compositor id; the fixed slots keep their historical names
+    int capture_number(int workspace_id) const {
+        return workspace_id <= special_slot ? workspace_id : view(workspace_id).hypr_id;
     }
 
-    GdkPixbuf* create_workspace_thumbnail_from_path(const std::string& screenshot_path) {
-        if (screenshot_path.empty() || !std::filesystem::exists(screenshot_path)) {
+    std::string get_screenshot_path(int workspace_id) const {
+        return std::string("/tmp/workspace_previews/workspace_") + std::to_string(capture_number(workspace_id)) + ".png";
+    }
+
+    // "#<generation>" of the workspace's latest capture, read from the mapped index without
+    // a syscall; empty when never captured. Without a readable index the first of the files
+    // that exists stands in with "@<modification time>", empty when neither does.
+    std::string preview_version(int workspace_id, const std::string& file, const std::string& fallback = "") const {
+        PreviewIndex::Version captured;
+        switch (preview_index.lookup(capture_number(workspace_id), captured)) {
+            case PreviewIndex::FOUND:
+                return "#" + std::to_string(captured.generation);
+            case PreviewIndex::NOT_CAPTURED:
+                return "";
+            case PreviewIndex::UNREADABLE:
+                break;
+        }
+        for (const std::string* path : {&file, &fallback}) {
+            std::error_code ec;
+            auto modified = std::filesystem::last_write_time(*path, ec);
+            if (!ec) {
+                return "@" + std::to_string(modified.time_since_epoch().count());
+            }
+        }
+        return "";
+    }
+
+    // The tooltip decodes its pyramid level, or the full capture when there is none
+    std::string thumbnail_version(int workspace_id) const {
+        return preview_version(workspace_id, get_preview_level_path(workspace_id, PreviewPyramid::TOOLTIP, scale_factor),
+                               get_screenshot_path(workspace_id));
+    }
+
+    // Scale thumbnail size based on screen resolution
+    int thumbnail_width() const {
+        return PreviewPyramid::thumbnail_width(screen_width);
+    }
+
+    int thumbnail_height() const {
+        return PreviewPyramid::thumbnail_height(screen_width);
+    }
+
+    std::string get_preview_level_path(int workspace_id, PreviewPyramid::Level level, int scale) const {
+        return PreviewPyramid::level_path("/tmp/workspace_previews", capture_number(workspace_id), level, scale);
+    }
+
+    TooltipJob make_tooltip_job(int workspace_id, guint64 generation) const {
+        int scale = scale_factor;
+        return {workspace_id, generation, get_screenshot_path(workspace_id),
+                get_preview_level_path(workspace_id, PreviewPyramid::TOOLTIP, scale), thumbnail_version(workspace_id),
+                scale};
+    }
+
+    // The capture generation retires a thumbnail as soon as the recorder publishes a new one
+    std::string thumbnail_cache_key(const std::string& screenshot_path, const std::string& version, int scale) const {
+        return screenshot_path + size_key(thumbnail_width(), scale) + version;
+    }
+
+    // Wraps a pixbuf decoded at device pixels in an image surface with the matching
+    // device scale, so widgets can share it and GTK draws it 1:1; consumes the pixbuf
+    static cairo_surface_t* surface_from_pixbuf(GdkPixbuf* pixbuf, int scale) {
+        if (!pixbuf) {
             return nullptr;
         }
+        cairo_surface_t* surface = gdk_cairo_surface_create_from_pixbuf(pixbuf, scale, nullptr);
+        g_object_unref(pixbuf);
+        return surface;
+    }
+
+    // The tooltip pyramid level decodes as is; a full capture is scaled while decoding
+    cairo_surface_t* create_workspace_thumbnail(const TooltipJob& job) {
+        Metrics::Timer timer(metrics, "decode_thumbnail");
+        int scale = job.scale;
         GError* error = nullptr;
-        // Scale thumbnail size based on screen resolution
-        int thumb_width = std::max(200, screen_width / 6);
-        int thumb_height = std::max(112, static_cast<int>(thumb_width * 9.0 / 16.0)); // 16:9 aspect ratio
+        if (std::filesystem::exists(job.level_path)) {
+            GdkPixbuf* pixbuf = gdk_pixbuf_new_from_file(job.level_path.c_str(), &error);
+            if (!error) {
+                return surface_from_pixbuf(pixbuf, scale);
+            }
+            g_error_free(error); // Fall back to the full capture
+            error = nullptr;
+        }
+        const std::string& screenshot_path = job.screenshot_path;
+        if (screenshot_path.empty() || !std::filesystem::exists(screenshot_path)) {
+            return nullptr;
+        }
+        int thumb_width = thumbnail_width() * scale;
+        int thumb_height = thumbnail_height() * scale;
         GdkPixbuf* pixbuf = gdk_pixbuf_new_from_file_at_size(
             screenshot_path.c_str(), thumb_width, thumb_height, &error);
         if (error) {
@@ -347,58 +1188,77 @@ public:
             g_error_free(error);
             return nullptr;
         }
-        return pixbuf;
+        return surface_from_pixbuf(pixbuf, scale);
     }
 
-    std::vector<std::string> get_workspace_app_classes(int workspace_id) {
-        std::vector<std::string> app_classes;
-        std::string command;
-        if (workspace_id == 13) {
-            // Special workspace query - get apps from special workspace "elysia"
-            command = "hyprctl clients -j 2>/dev/null | jq -r '.[] | select(.workspace.name == \"special:elysia\") | .class' 2>/dev/null";
-        } else {
-            // Regular workspace query
-            command = "hyprctl clients -j 2>/dev/null | jq -r '.[] | select(.workspace.id == " +
-                     std::to_string(workspace_id) + ") | .class' 2>/dev/null";
-        }
-        FILE* pipe = popen(command.c_str(), "r");
-        if (!pipe) {
-            return app_classes;
+    // Draws a workspace's windows as scaled rectangles with their app icons, straight
+    // from the snapshot geometry: no capture, no decode, never out of date
+    cairo_surface_t* create_workspace_minimap(int workspace_id, int scale) {
+        const WorkspaceRecord* record = find_record(workspace_id);
+        MonitorRect bounds;
+        if (!record || record->window_count == 0 || !snapshot->layout_bounds(*record, bounds)) {
+            return nullptr;
         }
-        char buffer[128];
-        while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-            std::string app_class = buffer;
-            if (!app_class.empty() && app_class.back() == '\n') {
-                app_class.pop_back();
+        Metrics::Timer timer(metrics, "render_minimap");
+        int width = thumbnail_width();
+        int height = thumbnail_height();
+        cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width * scale, height * scale);
+        cairo_surface_set_device_scale(surface, scale, scale);
+        cairo_t* cr = cairo_create(surface);
+        double k = std::min(width / static_cast<double>(bounds.width), height / static_cast<double>(bounds.height));
+        double origin_x = (width - bounds.width * k) / 2;
+        double origin_y = (height - bounds.height * k) / 2;
+        // The output itself
+        cairo_set_source_rgba(cr, 0.0, 0.0, 0.0, 0.35);
+        cairo_rectangle(cr, origin_x, origin_y, bounds.width * k, bounds.height * k);
+        cairo_fill(cr);
+        cairo_set_line_width(cr, 1.0);
+        for (const WindowEntry* w = snapshot->windows_begin(*record); w != snapshot->windows_end(*record); ++w) {
+            double x = origin_x + (w->x - bounds.x) * k;
+            double y = origin_y + (w->y - bounds.y) * k;
+            double window_width = w->width * k;
+            double window_height = w->height * k;
+            cairo_rectangle(cr, x + 1.5, y + 1.5, std::max(0.0, window_width - 3), std::max(0.0, window_height - 3));
+            cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.12);
+            cairo_fill_preserve(cr);
+            cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.6);
+            cairo_stroke(cr);
+            // Icons share the app icon cache and are only drawn where they fit
+            if (window_width < app_icon_size + 4 || window_height < app_icon_size + 4) {
+                continue;
             }
-            if (!app_class.empty()) {
-                app_classes.push_back(app_class);
+            cairo_surface_t* app_icon = get_app_icon(snapshot->str(w->class_id));
+            if (app_icon) {
+                cairo_set_source_surface(cr, app_icon, x + (window_width - app_icon_size) / 2,
+                                         y + (window_height - app_icon_size) / 2);
+                cairo_paint(cr);
+                cairo_surface_destroy(app_icon);
             }
         }
-        pclose(pipe);
-        return app_classes;
+        cairo_destroy(cr);
+        return surface;
     }
 
-    GdkPixbuf* get_app_icon(const std::string& app_class) {
+    cairo_surface_t* get_app_icon(const std::string& app_class) {
         if (app_class.empty()) {
             return nullptr;
         }
         // Check cache first
-        {
-            std::lock_guard<std::mutex> lock(cache_mutex);
-            auto it = theme_icon_cache.find(app_class);
-            if (it != theme_icon_cache.end()) {
-                return it->second ? g_object_ref(it->second) : nullptr;
-            }
+        int scale = scale_factor;
+        std::string cache_key = app_class + size_key(app_icon_size, scale);
+        cairo_surface_t* cached = nullptr;
+        if (image_cache.lookup(ImageCache::APP_ICON, cache_key, &cached)) {
+            return cached;
         }
+        Metrics::Timer timer(metrics, "decode_app_icon");
         GtkIconTheme* theme = gtk_icon_theme_get_default();
         std::string icon_name = app_class;
         if (!gtk_icon_theme_has_icon(theme, icon_name.c_str())) {
             std::transform(icon_name.begin(), icon_name.end(), icon_name.begin(), ::tolower);
         }
         GError* error = nullptr;
-        GdkPixbuf* pixbuf = gtk_icon_theme_load_icon(theme, icon_name.c_str(), app_icon_size,
-                                                   GTK_ICON_LOOKUP_FORCE_SIZE, &error);
+        GdkPixbuf* pixbuf = gtk_icon_theme_load_icon_for_scale(theme, icon_name.c_str(), app_icon_size, scale,
+                                                             GTK_ICON_LOOKUP_FORCE_SIZE, &error);
         if (error) {
             g_error_free(error);
             // Try fallbacks efficiently
@@ -407,46 +1267,249 @@ public:
             };
             for (const auto& fallback : fallbacks) {
                 error = nullptr;
-                pixbuf = gtk_icon_theme_load_icon(theme, fallback.c_str(), app_icon_size,
-                                                GTK_ICON_LOOKUP_FORCE_SIZE, &error);
+                pixbuf = gtk_icon_theme_load_icon_for_scale(theme, fallback.c_str(), app_icon_size, scale,
+                                                          GTK_ICON_LOOKUP_FORCE_SIZE, &error);
                 if (pixbuf && !error) break;
                 if (error) g_error_free(error);
             }
         }
         // Cache the result (even if null)
+        cairo_surface_t* surface = surface_from_pixbuf(pixbuf, scale);
+        image_cache.insert(ImageCache::APP_ICON, cache_key, surface);
+        return surface;
+    }
+
+    // Center of a workspace button in overlay coordinates. Ring slots are spread
+    // evenly over the buttons on the current page, starting at the top.
+    void get_workspace_center(int workspace_id, int& x, int& y) {
+        x = center_x;
+        y = center_y;
+        auto it = std::find(shown_ring_slots.begin(), shown_ring_slots.end(), workspace_id);
+        if (workspace_id == special_slot || it == shown_ring_slots.end()) {
+            return;
+        }
+        int count = std::max(numbered_workspace_count, static_cast<int>(shown_ring_slots.size()));
+        double angle = (it - shown_ring_slots.begin()) * (2 * M_PI / count) - (M_PI / 2);
+        x = center_x + radius * cos(angle);
+        y = center_y + radius * sin(angle);
+    }
+
+    // Track the pointer's heading so tooltip data can be ready before it arrives
+    void on_pointer_motion(double x, double y, guint32 time) {
+        if (pointer_time != 0 && time > pointer_time) {
+            double dt = static_cast<double>(time - pointer_time);
+            double vx = (x - pointer_x) / dt;
+            double vy = (y - pointer_y) / dt;
+            // Smooth so a single jittery event doesn't flip the heading
+            pointer_vx = 0.6 * vx + 0.4 * pointer_vx;
+            pointer_vy = 0.6 * vy + 0.4 * pointer_vy;
+        }
+        pointer_x = x;
+        pointer_y = y;
+        pointer_time = time;
+        if (!low_power) {
+            prefetch_along_heading(); // Speculative decodes are a luxury on battery
+        }
+    }
+
+    void prefetch_along_heading() {
+        double speed = std::hypot(pointer_vx, pointer_vy);
+        if (speed < 0.2) {
+            return; // Resting or drifting - no meaningful heading
+        }
+        double dir_x = pointer_vx / speed;
+        double dir_y = pointer_vy / speed;
+        // Project every button onto the heading ray, keep those inside a narrow cone
+        std::vector<std::pair<double, int>> candidates;
+        std::vector<int> visible(shown_ring_slots);
+        visible.push_back(special_slot);
+        for (int workspace_id : visible) {
+            int bx, by;
+            get_workspace_center(workspace_id, bx, by);
+            double dx = bx - pointer_x;
+            double dy = by - pointer_y;
+            double along = dx * dir_x + dy * dir_y;
+            if (along <= 0.0) {
+                continue; // Behind the pointer
+            }
+            double across = std::fabs(dx * dir_y - dy * dir_x);
+            double hit_radius = (workspace_id == special_slot ? special_button_size : button_size) / 2.0;
+            // Button radius plus ~15 degrees of heading error
+            if (across > hit_radius + along * 0.27) {
+                continue;
+            }
+            candidates.emplace_back(along, workspace_id);
+        }
+        std::sort(candidates.begin(), candidates.end());
+        // Only the first one or two buttons along the ray are worth fetching
+        std::vector<int> predicted;
+        for (size_t i = 0; i < candidates.size() && i < 2; i++) {
+            predicted.push_back(candidates[i].second);
+        }
+        retain_prefetch_jobs(predicted);
+        for (int workspace_id : predicted) {
+            queue_prefetch(workspace_id);
+        }
+    }
+
+    void queue_prefetch(int workspace_id) {
+        if (!needs_thumbnail(workspace_id) || tooltip_jobs_pending.count(workspace_id)) {
+            return;
+        }
+        prefetch_issued++;
+        queue_tooltip_job(make_tooltip_job(workspace_id, 0));
+    }
+
+    // Drop queued predictions the pointer is no longer heading toward
+    void retain_prefetch_jobs(const std::vector<int>& predicted) {
+        std::lock_guard<std::mutex> lock(tooltip_job_mutex);
+        for (auto it = tooltip_jobs.begin(); it != tooltip_jobs.end();) {
+            if (it->generation == 0 &&
+                std::find(predicted.begin(), predicted.end(), it->workspace_id) == predicted.end()) {
+                tooltip_jobs_pending.erase(it->workspace_id);
+                it = tooltip_jobs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void queue_tooltip_job(const TooltipJob& job) {
+        // Started lazily so a quick keyboard switch never pays for the thread
+        if (!tooltip_thread.joinable()) {
+            tooltip_thread = std::thread(&WorkspaceSwitcher::tooltip_worker, this);
+        }
+        tooltip_jobs_pending.insert(job.workspace_id);
         {
-            std::lock_guard<std::mutex> lock(cache_mutex);
-            theme_icon_cache[app_class] = pixbuf ? g_object_ref(pixbuf) : nullptr;
+            std::lock_guard<std::mutex> lock(tooltip_job_mutex);
+            // The hovered workspace jumps ahead of any predictions
+            if (job.generation != 0) {
+                tooltip_jobs.push_front(job);
+            } else {
+                tooltip_jobs.push_back(job);
+            }
         }
-        return pixbuf;
+        tooltip_job_cv.notify_one();
     }
 
-    // Lazy loading for tooltip data - only fetch when needed
-    std::vector<std::string> get_workspace_apps(int workspace_id) {
-        std::vector<std::string> apps;
-        std::string command;
-        if (workspace_id == 13) {
-            // Special workspace query - get apps from special workspace "elysia"
-            command = "hyprctl clients -j 2>/dev/null | jq -r '.[] | select(.workspace.name == \"special:elysia\") | .title' 2>/dev/null";
-        } else {
-            // Regular workspace query
-            command = "hyprctl clients -j 2>/dev/null | jq -r '.[] | select(.workspace.id == " +
-                     std::to_string(workspace_id) + ") | .title' 2>/dev/null";
+    // Hovering a workspace whose prefetch is still queued turns it into the hover job
+    bool promote_queued_job(int workspace_id, guint64 generation) {
+        std::lock_guard<std::mutex> lock(tooltip_job_mutex);
+        for (auto it = tooltip_jobs.begin(); it != tooltip_jobs.end(); ++it) {
+            if (it->workspace_id == workspace_id) {
+                TooltipJob job = *it;
+                job.generation = generation;
+                tooltip_jobs.erase(it);
+                tooltip_jobs.push_front(job);
+                return true;
+            }
         }
-        FILE* pipe = popen(command.c_str(), "r");
-        if (!pipe) return apps;
-        char buffer[256];
-        while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-            std::string title = buffer;
-            if (!title.empty() && title.back() == '\n') {
-                title.pop_back();
+        return false;
+    }
+
+    // Called when the pointer leaves a button: queued hover work is dropped and
+    // an in-flight job skips its decode
+    void cancel_tooltip_jobs() {
+        hovered_workspace = 0;
+        tooltip_generation++;
+        std::lock_guard<std::mutex> lock(tooltip_job_mutex);
+        for (auto it = tooltip_jobs.begin(); it != tooltip_jobs.end();) {
+            if (it->generation != 0) {
+                tooltip_jobs_pending.erase(it->workspace_id);
+                it = tooltip_jobs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    struct TooltipResult {
+        WorkspaceSwitcher* self;
+        int workspace_id;
+        guint64 generation;
+        bool has_thumbnail; // Thumbnail decode finished and landed in image_cache
+    };
+
+    bool is_job_stale(const TooltipJob& job) const {
+        return job.generation != 0 && job.generation != tooltip_generation.load();
+    }
+
+    void post_tooltip_result(TooltipResult* result) {
+        g_idle_add(on_tooltip_result_static, result);
+    }
+
+    // Runs on the tooltip thread. Titles come from the workspace model, so the only
+    // slow stage is the thumbnail decode; stale hover jobs skip it.
+    void tooltip_worker() {
+        while (true) {
+            TooltipJob job;
+            {
+                std::unique_lock<std::mutex> lock(tooltip_job_mutex);
+                tooltip_job_cv.wait(lock, [this] { return tooltip_thread_stop || !tooltip_jobs.empty(); });
+                if (tooltip_thread_stop) {
+                    return;
+                }
+                job = tooltip_jobs.front();
+                tooltip_jobs.pop_front();
             }
-            if (!title.empty()) {
-                apps.push_back(title);
+            bool decoded = false;
+            if (!is_job_stale(job)) {
+                cairo_surface_t* thumbnail = create_workspace_thumbnail(job);
+                image_cache.insert(ImageCache::THUMBNAIL, thumbnail_cache_key(job.screenshot_path, job.version, job.scale), thumbnail);
+                if (thumbnail) cairo_surface_destroy(thumbnail);
+                decoded = true;
             }
+            post_tooltip_result(new TooltipResult{this, job.workspace_id, job.generation, decoded});
+        }
+    }
+
+    void apply_tooltip_result(TooltipResult* result) {
+        tooltip_jobs_pending.erase(result->workspace_id);
+        if (result->has_thumbnail && result->generation == 0) {
+            prefetched_workspaces.insert(result->workspace_id);
+        }
+        if (result->workspace_id != hovered_workspace) {
+            return;
+        }
+        // A job cancelled by an earlier hover of the same button may finish without decoding
+        if (!result->has_thumbnail && needs_thumbnail(result->workspace_id)) {
+            queue_tooltip_job(make_tooltip_job(result->workspace_id, tooltip_generation.load()));
+        }
+        render_tooltip(result->workspace_id);
+    }
+
+    // Thumbnail not resident yet; only workspaces with windows show one. Before the
+    // first snapshot arrives every workspace might have windows.
+    bool needs_thumbnail(int workspace_id) {
+        if (preview_mode == SwitcherOptions::PREVIEW_MINIMAP) {
+            return false; // Never decodes anything
+        }
+        if (snapshot && !workspace_has_windows(workspace_id)) {
+            return false;
+        }
+        return !image_cache.contains(ImageCache::THUMBNAIL,
+                                     thumbnail_cache_key(get_screenshot_path(workspace_id), thumbnail_version(workspace_id), scale_factor));
+    }
+
+    void stop_tooltip_worker() {
+        if (!tooltip_thread.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(tooltip_job_mutex);
+            tooltip_thread_stop = true;
+        }
+        tooltip_job_cv.notify_one();
+        tooltip_thread.join();
+    }
+
+    void report_prefetch_stats() {
+        if (!verbose || (tooltip_requests == 0 && prefetch_issued == 0)) {
+            return;
         }
-        pclose(pipe);
-        return apps;
+        int hit_rate = tooltip_requests > 0 ? (prefetch_hits * 100) / tooltip_requests : 0;
+        std::cerr << "Prefetch: " << prefetch_issued << " issued, " << prefetch_hits << "/" << tooltip_requests
+                  << " tooltips served from prefetch (" << hit_rate << "% hit rate)" << std::endl;
     }
 
     void create_tooltip() {
@@ -486,7 +1549,7 @@ public:
         gtk_window_set_default_size(GTK_WINDOW(window), screen_width, screen_height);
         gtk_window_set_accept_focus(GTK_WINDOW(window), TRUE);
         gtk_window_set_focus_on_map(GTK_WINDOW(window), TRUE);
-        gtk_widget_add_events(window, GDK_KEY_PRESS_MASK);
+        gtk_widget_add_events(window, GDK_KEY_PRESS_MASK | GDK_POINTER_MOTION_MASK | GDK_SCROLL_MASK);
         // Enable compositing for smooth animations
         gtk_widget_set_app_paintable(window, TRUE);
         fixed = gtk_fixed_new();
@@ -505,95 +1568,214 @@ public:
 
     // Create buttons immediately without icons for fastest startup
     void create_workspace_buttons_minimal() {
-        // Create regular workspaces 1-12 in circle
-        for (int i = 1; i <= 12; i++) {
-            double angle = (i - 1) * (2 * M_PI / 12) - (M_PI / 2);
-            int x = center_x + radius * cos(angle);
-            int y = center_y + radius * sin(angle);
-            GtkWidget* button = gtk_button_new_with_label(std::to_string(i).c_str());
-            gtk_widget_set_size_request(button, button_size, button_size);
-            gtk_button_set_relief(GTK_BUTTON(button), GTK_RELIEF_NONE);
-            // Minimal styling - just add the basic classes
-            GtkStyleContext* context = gtk_widget_get_style_context(button);
-            gtk_style_context_add_class(context, "workspace-button");
-            gtk_style_context_add_class(context, ("workspace-" + std::to_string(i)).c_str());
-            // Essential event handling only
-            g_signal_connect(button, "enter-notify-event", G_CALLBACK(WorkspaceSwitcher::on_button_enter_static), this);
-            g_signal_connect(button, "leave-notify-event", G_CALLBACK(WorkspaceSwitcher::on_button_leave_static), this);
-            gtk_widget_set_events(button, GDK_ENTER_NOTIFY_MASK | GDK_LEAVE_NOTIFY_MASK);
-            g_object_set_data(G_OBJECT(button), "workspace", GINT_TO_POINTER(i));
-            g_signal_connect(button, "clicked", G_CALLBACK(WorkspaceSwitcher::on_workspace_click_static), this);
-            gtk_fixed_put(GTK_FIXED(fixed), button, x - button_size/2, y - button_size/2);
-            // Store button reference for later icon updates
-            workspace_buttons[i] = button;
-        }
-        // Create workspace 13 in the center - bigger than others
-        GtkWidget* special_button = gtk_button_new_with_label("13");
-        gtk_widget_set_size_request(special_button, special_button_size, special_button_size);
-        gtk_button_set_relief(GTK_BUTTON(special_button), GTK_RELIEF_NONE);
-        // Styling for special workspace
-        GtkStyleContext* special_context = gtk_widget_get_style_context(special_button);
-        gtk_style_context_add_class(special_context, "workspace-button");
-        gtk_style_context_add_class(special_context, "workspace-13");
-        // Event handling
-        g_signal_connect(special_button, "enter-notify-event", G_CALLBACK(WorkspaceSwitcher::on_button_enter_static), this);
-        g_signal_connect(special_button, "leave-notify-event", G_CALLBACK(WorkspaceSwitcher::on_button_leave_static), this);
-        gtk_widget_set_events(special_button, GDK_ENTER_NOTIFY_MASK | GDK_LEAVE_NOTIFY_MASK);
-        g_object_set_data(G_OBJECT(special_button), "workspace", GINT_TO_POINTER(13));
-        g_signal_connect(special_button, "clicked", G_CALLBACK(WorkspaceSwitcher::on_workspace_click_static), this);
-        // Position in center
-        // The calculation `center_x - special_button_size/2` correctly centers the larger button
-        gtk_fixed_put(GTK_FIXED(fixed), special_button, center_x - special_button_size/2, center_y - special_button_size/2);
-        // Store button reference
-        workspace_buttons[13] = special_button;
+        // Ring workspaces on the first page, then workspace 13 in the center - bigger than others
+        build_ring_page();
+        create_workspace_button(special_slot);
+    }
+
+    // Button label: the number for the fixed slots, the workspace name for extras
+    std::string workspace_label(int slot) const {
+        if (slot <= special_slot) {
+            return std::to_string(slot);
+        }
+        const std::string& name = view(slot).name;
+        return is_extra_special(slot) ? name.substr(8) : name;
+    }
+
+    void create_workspace_button(int slot) {
+        int size = slot == special_slot ? special_button_size : button_size;
+        int x, y;
+        get_workspace_center(slot, x, y);
+        GtkWidget* button = gtk_button_new_with_label(workspace_label(slot).c_str());
+        gtk_widget_set_size_request(button, size, size);
+        gtk_button_set_relief(GTK_BUTTON(button), GTK_RELIEF_NONE);
+        // Minimal styling - just add the basic classes
+        GtkStyleContext* context = gtk_widget_get_style_context(button);
+        gtk_style_context_add_class(context, "workspace-button");
+        if (slot <= special_slot) {
+            gtk_style_context_add_class(context, ("workspace-" + std::to_string(slot)).c_str());
+        } else {
+            gtk_style_context_add_class(context, "workspace-extra");
+        }
+        if (search_match_slots.count(slot)) {
+            gtk_style_context_add_class(context, "search-match");
+        }
+        // Essential event handling only
+        g_signal_connect(button, "enter-notify-event", G_CALLBACK(WorkspaceSwitcher::on_button_enter_static), this);
+        g_signal_connect(button, "leave-notify-event", G_CALLBACK(WorkspaceSwitcher::on_button_leave_static), this);
+        gtk_widget_set_events(button, GDK_ENTER_NOTIFY_MASK | GDK_LEAVE_NOTIFY_MASK);
+        g_object_set_data(G_OBJECT(button), "workspace", GINT_TO_POINTER(slot));
+        g_signal_connect(button, "clicked", G_CALLBACK(WorkspaceSwitcher::on_workspace_click_static), this);
+        make_drag_source(button, slot);
+        gtk_drag_dest_set(button, GTK_DEST_DEFAULT_ALL, &drag_target, 1, GDK_ACTION_MOVE);
+        g_signal_connect(button, "drag-data-received", G_CALLBACK(WorkspaceSwitcher::on_drag_data_received_static), this);
+        gtk_fixed_put(GTK_FIXED(fixed), button, x - size/2, y - size/2);
+        gtk_widget_show_all(button);
+        // Store button reference for later icon updates
+        view(slot).button = button;
+    }
+
+    void destroy_slot_widgets(int slot) {
+        WorkspaceView& workspace_view = view(slot);
+        if (slot == hovered_workspace) {
+            hide_tooltip();
+        }
+        for (GtkWidget* widget : workspace_view.app_icons) {
+            gtk_widget_destroy(widget);
+        }
+        workspace_view.app_icons.clear();
+        if (workspace_view.button) {
+            gtk_widget_destroy(workspace_view.button);
+            workspace_view.button = nullptr;
+        }
+    }
+
+    int ring_page_count() const {
+        return std::max(1, static_cast<int>((ring_slots.size() + ring_page_size - 1) / ring_page_size));
+    }
+
+    // Replaces the ring widgets with those of the current page; cost is bounded by
+    // the page size no matter how many workspaces exist
+    void build_ring_page() {
+        for (int slot : shown_ring_slots) {
+            destroy_slot_widgets(slot);
+        }
+        ring_page = std::min(ring_page, ring_page_count() - 1);
+        size_t first = static_cast<size_t>(ring_page) * ring_page_size;
+        size_t last = std::min(ring_slots.size(), first + ring_page_size);
+        shown_ring_slots.assign(ring_slots.begin() + first, ring_slots.begin() + last);
+        for (int slot : shown_ring_slots) {
+            create_workspace_button(slot);
+        }
+        if (snapshot) {
+            for (int slot : shown_ring_slots) {
+                load_workspace_app_icons(slot);
+            }
+        }
+        if (view(special_slot).button) {
+            queue_workspace_icons(); // Otherwise the constructor queues them at startup
+        }
+        update_page_label();
+    }
+
+    void update_page_label() {
+        int pages = ring_page_count();
+        if (pages <= 1) {
+            if (page_label) gtk_widget_hide(page_label);
+            return;
+        }
+        if (!page_label) {
+            page_label = gtk_label_new("");
+            gtk_widget_set_size_request(page_label, special_button_size, -1);
+            gtk_style_context_add_class(gtk_widget_get_style_context(page_label), "page-indicator");
+            gtk_fixed_put(GTK_FIXED(fixed), page_label, center_x - special_button_size/2,
+                          center_y - special_button_size/2 - 40);
+        }
+        std::string text = "‹ " + std::to_string(ring_page + 1) + " / " + std::to_string(pages) + " ›";
+        gtk_label_set_text(GTK_LABEL(page_label), text.c_str());
+        gtk_widget_show(page_label);
+    }
+
+    void turn_page(int delta) {
+        int pages = ring_page_count();
+        if (pages <= 1) {
+            return;
+        }
+        ring_page = (ring_page + delta + pages) % pages;
+        build_ring_page();
     }
 
+    // Shows the header immediately; titles follow the first snapshot and the
+    // thumbnail is filled in by apply_tooltip_result once decoded
     void show_tooltip(int workspace_id, gint x, gint y) {
         // Only show tooltip if it's been created (deferred creation)
         if (!tooltip_window) return;
-        
-        // Load tooltip data on-demand for better performance
-        std::vector<std::string> apps = get_workspace_apps(workspace_id);
-        
-        // Only show thumbnail image if workspace has apps
-        if (!apps.empty()) {
-            std::string screenshot_path = get_screenshot_path(workspace_id);
-            GdkPixbuf* thumbnail = create_workspace_thumbnail_from_path(screenshot_path);
-            if (thumbnail) {
-                gtk_image_set_from_pixbuf(GTK_IMAGE(tooltip_image), thumbnail);
-                gtk_widget_show(tooltip_image);
-                g_object_unref(thumbnail);
-            } else {
-                // Clear and hide image if screenshot doesn't exist
-                gtk_image_clear(GTK_IMAGE(tooltip_image));
-                gtk_widget_hide(tooltip_image);
+        tooltip_requests++;
+        hovered_workspace = workspace_id;
+        tooltip_anchor_x = x;
+        tooltip_anchor_y = y;
+        guint64 generation = ++tooltip_generation;
+        bool complete = snapshot && !needs_thumbnail(workspace_id);
+        if (prefetched_workspaces.erase(workspace_id) && complete) {
+            prefetch_hits++;
+        }
+        if (needs_thumbnail(workspace_id) && !promote_queued_job(workspace_id, generation) &&
+            !tooltip_jobs_pending.count(workspace_id)) {
+            queue_tooltip_job(make_tooltip_job(workspace_id, generation));
+        }
+        render_tooltip(workspace_id);
+    }
+
+    // Cuts a title to max_chars characters without splitting a UTF-8 sequence
+    static std::string truncate_title(const std::string& title, size_t max_chars) {
+        size_t chars = 0;
+        for (size_t i = 0; i < title.size(); i++) {
+            if ((static_cast<unsigned char>(title[i]) & 0xC0) != 0x80 && chars++ == max_chars) {
+                return title.substr(0, i) + "…";
             }
+        }
+        return title;
+    }
+
+    // The list is capped so a workspace with dozens of windows still lays out a small label
+    void render_tooltip(int workspace_id) {
+        size_t app_count = 0;
+        std::vector<std::string> apps =
+            workspace_strings(workspace_id, &WindowEntry::title_id, max_tooltip_titles, &app_count);
+        
+        // Only show thumbnail image once decoded and if workspace has apps;
+        // the minimap stands in until then, or for workspaces never captured
+        cairo_surface_t* thumbnail = nullptr;
+        if (!apps.empty() && preview_mode != SwitcherOptions::PREVIEW_MINIMAP) {
+            image_cache.lookup(ImageCache::THUMBNAIL, thumbnail_cache_key(get_screenshot_path(workspace_id), thumbnail_version(workspace_id), scale_factor),
+                               &thumbnail);
+        }
+        if (!apps.empty() && !thumbnail && preview_mode != SwitcherOptions::PREVIEW_CAPTURE) {
+            thumbnail = create_workspace_minimap(workspace_id, scale_factor);
+        }
+        if (thumbnail) {
+            gtk_image_set_from_surface(GTK_IMAGE(tooltip_image), thumbnail);
+            gtk_widget_show(tooltip_image);
         } else {
-            // Clear and hide image if workspace is empty (prevents showing previous workspace's image)
+            // Clear and hide image (prevents showing previous workspace's image)
             gtk_image_clear(GTK_IMAGE(tooltip_image));
             gtk_widget_hide(tooltip_image);
         }
         
-        std::string tooltip_text = "Workspace " + std::to_string(workspace_id);
-        if (workspace_id == 13) {
+        std::string tooltip_text = "Workspace " + workspace_label(workspace_id);
+        if (workspace_id == special_slot) {
             tooltip_text = "Special Workspace (Elysia)";
+        } else if (is_extra_special(workspace_id)) {
+            tooltip_text = "Special Workspace (" + workspace_label(workspace_id) + ")";
         }
-        if (apps.empty()) {
+        if (!snapshot) {
+            // Header only until the first snapshot arrives
+        } else if (apps.empty()) {
             tooltip_text += "\nNothing";
         } else {
-            tooltip_text += " (" + std::to_string(apps.size()) + " apps):";
+            tooltip_text += " (" + std::to_string(app_count) + " apps):";
             for (const auto& app : apps) {
-                tooltip_text += "\n• " + app;
+                tooltip_text += "\n• " + truncate_title(app, max_title_chars);
+            }
+            if (app_count > apps.size()) {
+                tooltip_text += "\n… and " + std::to_string(app_count - apps.size()) + " more";
             }
         }
         gtk_label_set_text(GTK_LABEL(tooltip_label), tooltip_text.c_str());
         gtk_widget_show_all(tooltip_window);
+        if (thumbnail) {
+            cairo_surface_destroy(thumbnail);
+        } else {
+            gtk_widget_hide(tooltip_image);
+        }
         
+        gint x = tooltip_anchor_x;
+        gint y = tooltip_anchor_y;
         GtkRequisition tooltip_size;
         gtk_widget_get_preferred_size(tooltip_window, &tooltip_size, nullptr);
         
         // Custom positioning for workspace 13
-        if (workspace_id == 13) {
+        if (workspace_id == special_slot) {
             // Position to the right of the central button with padding
             x = center_x;  // 20px padding from button edge
             // Vertically centered: y passed in is the bottom edge of the button
@@ -632,106 +1814,291 @@ public:
     }
 
     void hide_tooltip() {
+        cancel_tooltip_jobs();
         if (tooltip_window) {
             gtk_widget_hide(tooltip_window);
         }
     }
 
+    // Checks the active window's workspace - this is more reliable than activeworkspace
+    // because activeworkspace can return the workspace switcher window's workspace
     bool is_currently_on_special_workspace() {
-        // Check active window's workspace - this is more reliable than activeworkspace
-        // because activeworkspace can return the workspace switcher window's workspace
-        std::string command = "hyprctl -j activewindow 2>/dev/null | jq -r '.workspace.id' 2>/dev/null";
-        FILE* pipe = popen(command.c_str(), "r");
-        if (!pipe) {
+        JsonValue active;
+        if (!HyprIPC::request_json("activewindow", active)) {
             return false;
         }
-        char buffer[128];
-        bool result = false;
-        if (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-            std::string workspace_id_str = buffer;
-            // Remove trailing newline and whitespace
-            while (!workspace_id_str.empty() && (workspace_id_str.back() == '\n' || workspace_id_str.back() == '\r' || workspace_id_str.back() == ' ')) {
-                workspace_id_str.pop_back();
-            }
-            // Special workspaces have negative IDs
-            try {
-                int workspace_id = std::stoi(workspace_id_str);
-                result = (workspace_id < 0);
-            } catch (...) {
-                // If parsing fails, try checking workspace name as fallback
-                pclose(pipe);
-                std::string name_command = "hyprctl -j activewindow 2>/dev/null | jq -r '.workspace.name' 2>/dev/null";
-                FILE* name_pipe = popen(name_command.c_str(), "r");
-                if (name_pipe) {
-                    char name_buffer[128];
-                    if (fgets(name_buffer, sizeof(name_buffer), name_pipe) != nullptr) {
-                        std::string workspace_name = name_buffer;
-                        while (!workspace_name.empty() && (workspace_name.back() == '\n' || workspace_name.back() == '\r' || workspace_name.back() == ' ')) {
-                            workspace_name.pop_back();
-                        }
-                        result = (workspace_name == "special:elysia" || workspace_name.find("special:") == 0);
-                    }
-                    pclose(name_pipe);
-                }
-                return result;
+        // Special workspaces have negative IDs
+        return active["workspace"]["id"].as_int() < 0 || active["workspace"]["name"].as_string().rfind("special:", 0) == 0;
+    }
+
+    // Dispatcher argument selecting a slot's workspace: its number, or name:<name> for named ones
+    std::string workspace_target(int slot) const {
+        if (slot <= numbered_workspace_count || view(slot).hypr_id > 0) {
+            return std::to_string(view(slot).hypr_id);
+        }
+        return "name:" + view(slot).name;
+    }
+
+    // Drag payload "<slot>\n<class>": an app icon moves its class, a ring button (no class) its workspace
+    static constexpr GtkTargetEntry drag_target = {const_cast<gchar*>("application/x-ely-workspace-drag"),
+                                                  GTK_TARGET_SAME_APP, 0};
+
+    void make_drag_source(GtkWidget* widget, int slot) {
+        g_object_set_data(G_OBJECT(widget), "workspace", GINT_TO_POINTER(slot));
+        gtk_drag_source_set(widget, GDK_BUTTON1_MASK, &drag_target, 1, GDK_ACTION_MOVE);
+        g_signal_connect(widget, "drag-begin", G_CALLBACK(WorkspaceSwitcher::on_drag_begin_static), this);
+        g_signal_connect(widget, "drag-data-get", G_CALLBACK(WorkspaceSwitcher::on_drag_data_get_static), this);
+    }
+
+    // movetoworkspacesilent argument for a slot; special workspaces go by their full name
+    std::string move_target(int slot) const {
+        const std::string& name = view(slot).name;
+        return name.rfind("special:", 0) == 0 ? name : workspace_target(slot);
+    }
+
+    // Dropping an app icon moves that class's windows (Shift: from every workspace);
+    // dropping a ring button swaps the two workspaces' windows (Shift: merges into the target)
+    void handle_drop(int from_slot, const std::string& app_class, int to_slot, bool shift) {
+        if (!snapshot || from_slot == to_slot) {
+            return;
+        }
+        std::string to_target = move_target(to_slot);
+        std::string from_target = move_target(from_slot);
+        if (!WindowMoves::is_safe_target(to_target) || !WindowMoves::is_safe_target(from_target)) {
+            std::cerr << "Cannot move windows to workspace " << to_target << std::endl;
+            return;
+        }
+        const WorkspaceRecord* from = find_record(from_slot);
+        const WorkspaceRecord* to = find_record(to_slot);
+        WindowMoves moves;
+        if (!app_class.empty()) {
+            if (shift || from) {
+                moves.move_class(*snapshot, shift ? nullptr : from, app_class, to_target);
+            }
+        } else {
+            if (from) {
+                moves.move_workspace(*snapshot, *from, to_target);
+            }
+            if (to && !shift) {
+                moves.move_workspace(*snapshot, *to, from_target);
+            }
+        }
+        send_moves(moves);
+    }
+
+    // Moves a workspace's windows to the first empty numbered workspace
+    void empty_workspace(int slot) {
+        const WorkspaceRecord* record = find_record(slot);
+        if (!snapshot || !record || record->window_count == 0) {
+            return;
+        }
+        for (int target = 1; target <= numbered_workspace_count; target++) {
+            const WorkspaceRecord* candidate = find_record(target);
+            if (target != slot && (!candidate || candidate->window_count == 0)) {
+                WindowMoves moves;
+                moves.move_workspace(*snapshot, *record, move_target(target));
+                send_moves(moves);
+                return;
             }
         }
-        pclose(pipe);
-        return result;
+        std::cerr << "No empty workspace to move " << workspace_label(slot) << "'s windows to" << std::endl;
+    }
+
+    // The ring catches up through the model's movewindow events
+    void send_moves(const WindowMoves& moves) {
+        if (moves.size() == 0) {
+            return;
+        }
+        std::string reply;
+        auto start = std::chrono::steady_clock::now();
+        bool ok = moves.send(reply);
+        metrics.observe("bulk_move", Metrics::elapsed_ms(start));
+        metrics.count("bulk_moved_windows", moves.size());
+        if (!ok) {
+            std::cerr << "Error moving " << moves.size() << " windows: " << reply << std::endl;
+        }
     }
 
     void switch_workspace(int workspace_num) {
-        bool is_on_special = is_currently_on_special_workspace();
-        // Debug: Get active window workspace info (more accurate than activeworkspace)
-        std::string debug_cmd = "hyprctl -j activewindow 2>/dev/null | jq -r '\"Window WS ID: \" + (.workspace.id | tostring) + \", Name: \" + .workspace.name' 2>/dev/null";
-        FILE* debug_pipe = popen(debug_cmd.c_str(), "r");
-        if (debug_pipe) {
-            char debug_buffer[256];
-            if (fgets(debug_buffer, sizeof(debug_buffer), debug_pipe) != nullptr) {
-                std::string debug_info = debug_buffer;
-                while (!debug_info.empty() && (debug_info.back() == '\n' || debug_info.back() == '\r')) {
-                    debug_info.pop_back();
+        dispatch_workspace(workspace_num);
+        record_dispatch();
+    }
+
+    // Straight over IPC, never through a shell: workspace names come from the compositor.
+    // Leaving special:elysia and switching go out as one batch, in order.
+    void dispatch_workspace(int workspace_num) {
+        bool special = workspace_num == special_slot || is_extra_special(workspace_num);
+        // Other special workspaces toggle like elysia does
+        std::string target = workspace_num == special_slot ? "elysia"
+                             : special                     ? workspace_label(workspace_num)
+                                                           : workspace_target(workspace_num);
+        if (!WindowMoves::is_safe_target(target)) {
+            std::cerr << "Refusing to switch to workspace " << target << std::endl;
+            return;
+        }
+        std::string command;
+        if (special) {
+            command = "dispatch togglespecialworkspace " + target;
+        } else if (is_currently_on_special_workspace()) {
+            command = "[[BATCH]]dispatch togglespecialworkspace elysia;dispatch workspace " + target;
+        } else {
+            command = "dispatch workspace " + target;
+        }
+        std::string reply;
+        if (!HyprIPC::dispatch(command, reply)) {
+            std::cerr << "Error switching to workspace " << target << ": " << reply << std::endl;
+        }
+    }
+
+    // Search mode keys: letters start a search (digits and the other bound keys
+    // keep switching workspaces), then every printable key edits the query
+    bool handle_search_key(GdkEventKey* event) {
+        gunichar ch = gdk_keyval_to_unicode(event->keyval);
+        bool modified = event->state & (GDK_CONTROL_MASK | GDK_MOD1_MASK);
+        if (!search_active) {
+            if (modified || !g_unichar_isalpha(ch)) {
+                return false;
+            }
+            search_active = true;
+        }
+        switch (event->keyval) {
+            case GDK_KEY_Escape:
+                end_search();
+                return true;
+            case GDK_KEY_BackSpace:
+                // Drop the last UTF-8 character
+                while (!search_query.empty() && (static_cast<unsigned char>(search_query.back()) & 0xC0) == 0x80) {
+                    search_query.pop_back();
+                }
+                if (!search_query.empty()) {
+                    search_query.pop_back();
                 }
-                std::cerr << "DEBUG: Switching to workspace " << workspace_num << ", is_on_special=" << (is_on_special ? "true" : "false") << ", " << debug_info << std::endl;
+                if (search_query.empty()) {
+                    end_search();
+                } else {
+                    update_search();
+                }
+                return true;
+            case GDK_KEY_Return:
+            case GDK_KEY_KP_Enter:
+                if (focus_search_match()) {
+                    gtk_main_quit();
+                }
+                return true;
+            default:
+                break;
+        }
+        if (modified || !ch || !g_unichar_isprint(ch)) {
+            return false; // Page keys and the like still work while searching
+        }
+        char utf8[6];
+        search_query.append(utf8, g_unichar_to_utf8(ch, utf8));
+        update_search();
+        return true;
+    }
+
+    void update_search() {
+        search_results.clear();
+        search_match_slots.clear();
+        if (snapshot) {
+            if (!window_search.is_built_for(snapshot->version)) {
+                window_search.build(*snapshot);
+            }
+            auto start = std::chrono::steady_clock::now();
+            search_results = window_search.rank(window_search.query(search_query), search_query, *snapshot);
+            metrics.observe("search_query", Metrics::elapsed_ms(start));
+            for (uint32_t window : search_results) {
+                const WorkspaceRecord& record = snapshot->workspaces[window_search.record_of(window)];
+                search_match_slots.insert(slot_for_record(*snapshot, record));
             }
-            pclose(debug_pipe);
         }
-        
-        if (workspace_num == 13) {
-            // Special workspace toggle
-            std::string command = "hyprctl dispatch togglespecialworkspace elysia &";
-            int result = system(command.c_str());
-            if (result == 0) {
-                std::cout << "Toggled special workspace elysia" << std::endl;
+        // Bring the best match's page into view
+        if (!search_results.empty()) {
+            int best = slot_for_record(*snapshot, snapshot->workspaces[window_search.record_of(search_results[0])]);
+            auto it = std::find(ring_slots.begin(), ring_slots.end(), best);
+            if (it != ring_slots.end() && !is_slot_visible(best)) {
+                ring_page = static_cast<int>(it - ring_slots.begin()) / ring_page_size;
+                build_ring_page();
+            }
+        }
+        update_search_highlight();
+        update_search_label();
+    }
+
+    void end_search() {
+        search_active = false;
+        search_query.clear();
+        search_results.clear();
+        search_match_slots.clear();
+        update_search_highlight();
+        if (search_label) {
+            gtk_widget_hide(search_label);
+        }
+    }
+
+    void update_search_highlight() {
+        std::vector<int> visible(shown_ring_slots);
+        visible.push_back(special_slot);
+        for (int slot : visible) {
+            if (!view(slot).button) continue;
+            GtkStyleContext* context = gtk_widget_get_style_context(view(slot).button);
+            if (search_match_slots.count(slot)) {
+                gtk_style_context_add_class(context, "search-match");
             } else {
-                std::cerr << "Error toggling special workspace" << std::endl;
+                gtk_style_context_remove_class(context, "search-match");
             }
+        }
+    }
+
+    void update_search_label() {
+        if (!search_label) {
+            search_label = gtk_label_new("");
+            gtk_widget_set_size_request(search_label, special_button_size * 2, -1);
+            gtk_style_context_add_class(gtk_widget_get_style_context(search_label), "search-label");
+            gtk_fixed_put(GTK_FIXED(fixed), search_label, center_x - special_button_size,
+                          center_y + special_button_size/2 + app_icon_size + 40);
+        }
+        std::string text = "Search: " + search_query;
+        if (!snapshot) {
+            // Nothing to search until the first snapshot arrives
+        } else if (search_results.empty()) {
+            text += "\nNo matches";
         } else {
-            // Regular workspace switch
-            if (is_on_special) {
-                // If currently on special workspace, toggle it off and switch to new workspace
-                // Use bash -c with && to ensure toggle completes before switching
-                std::string combined_cmd = "bash -c \"hyprctl dispatch togglespecialworkspace elysia && hyprctl dispatch workspace " + std::to_string(workspace_num) + "\" &";
-                int result = system(combined_cmd.c_str());
-                if (result == 0) {
-                    std::cout << "Toggled special workspace off and switched to workspace " << workspace_num << std::endl;
-                } else {
-                    std::cerr << "Error switching from special workspace to workspace " << workspace_num << std::endl;
-                }
-            } else {
-                // Normal workspace switch
-                std::string command = "hyprctl dispatch workspace " + std::to_string(workspace_num) + " &";
-                int result = system(command.c_str());
-                if (result == 0) {
-                    std::cout << "Switched to workspace " << workspace_num << std::endl;
-                } else {
-                    std::cerr << "Error switching to workspace " << workspace_num << std::endl;
-                }
+            const WindowEntry& best = snapshot->windows[search_results[0]];
+            text += "\n" + truncate_title(snapshot->str(best.title_id), max_title_chars);
+            if (search_results.size() > 1) {
+                text += "\n(" + std::to_string(search_results.size() - 1) + " more)";
             }
         }
+        gtk_label_set_text(GTK_LABEL(search_label), text.c_str());
+        gtk_widget_show(search_label);
+    }
+
+    // Focuses the best match over IPC; it lands on whatever workspace holds it
+    bool focus_search_match() {
+        if (search_results.empty()) {
+            return false;
+        }
+        char command[64];
+        snprintf(command, sizeof(command), "dispatch focuswindow address:0x%llx",
+                 static_cast<unsigned long long>(snapshot->windows[search_results[0]].address));
+        std::string reply;
+        auto start = std::chrono::steady_clock::now();
+        bool ok = HyprIPC::request(command, reply) && reply == "ok";
+        metrics.observe("ipc_rtt", Metrics::elapsed_ms(start));
+        record_dispatch();
+        if (!ok) {
+            std::cerr << "Error focusing window: " << reply << std::endl;
+        }
+        return ok;
     }
 
     gboolean on_key_press(GdkEventKey* event) {
+        input_time = std::chrono::steady_clock::now();
+        input_from_key = true;
+        if (handle_search_key(event)) {
+            return TRUE;
+        }
         // Fast key handling
         switch (event->keyval) {
             case GDK_KEY_Escape: gtk_main_quit(); return TRUE;
@@ -747,7 +2114,10 @@ public:
             case GDK_KEY_0: switch_workspace(10); gtk_main_quit(); return TRUE;
             case GDK_KEY_minus:  switch_workspace(11); gtk_main_quit(); return TRUE;
             case GDK_KEY_equal:  switch_workspace(12); gtk_main_quit(); return TRUE;
-            case GDK_KEY_BackSpace: switch_workspace(13); gtk_main_quit(); return TRUE; // Backspace for workspace 13
+            case GDK_KEY_BackSpace: switch_workspace(special_slot); gtk_main_quit(); return TRUE; // Backspace for the special workspace
+            case GDK_KEY_Page_Down: turn_page(1); return TRUE;
+            case GDK_KEY_Page_Up: turn_page(-1); return TRUE;
+            case GDK_KEY_Delete: empty_workspace(hovered_workspace); return TRUE;
             default: return FALSE;
         }
     }
@@ -755,6 +2125,9 @@ public:
     void connect_signals() {
         g_signal_connect(window, "destroy", G_CALLBACK(WorkspaceSwitcher::on_destroy_static), this);
         g_signal_connect(window, "key-press-event", G_CALLBACK(WorkspaceSwitcher::on_key_press_static), this);
+        g_signal_connect(window, "motion-notify-event", G_CALLBACK(WorkspaceSwitcher::on_motion_notify_static), this);
+        g_signal_connect(window, "scroll-event", G_CALLBACK(WorkspaceSwitcher::on_scroll_static), this);
+        g_signal_connect(window, "notify::scale-factor", G_CALLBACK(WorkspaceSwitcher::on_scale_factor_changed_static), this);
         gtk_widget_set_can_focus(window, TRUE);
         gtk_widget_grab_focus(window);
     }
@@ -787,7 +2160,8 @@ public:
         g_object_unref(provider);
     }
 
-    // Full CSS loaded asynchronously after startup
+    // Full CSS loaded asynchronously after startup: these rules plus the theme's
+    // fonts and glow colors in one provider, replaced whole when the theme changes
     void apply_full_css() {
         const char* css_data = R"(
             @keyframes pulse-glow {
@@ -832,6 +2206,10 @@ public:
             .workspace-icon {
                 animation: fade-in 0.3s ease-out;
             }
+            .workspace-live {
+                border-radius: 12px;
+                animation: fade-in 0.3s ease-out;
+            }
             .workspace-button {
                 background: transparent;
                 border: none;
@@ -851,136 +2229,20 @@ public:
                 transform: scale(0.95);
                 transition: all 0.05s ease;
             }
-            /* Individual workspace glow effects */
-            .workspace-1:hover {
-                color: rgb(173, 216, 230);
-                box-shadow:
-                    inset 0 0 15px rgba(173, 216, 230, 0.6),
-                    inset 0 0 30px rgba(173, 216, 230, 0.4),
-                    0 0 20px rgb(173, 216, 230),
-                    0 0 40px rgb(173, 216, 230),
-                    0 0 60px rgb(173, 216, 230);
-                animation: pulse-glow 1.5s infinite ease-in-out;
-            }
-            .workspace-2:hover {
-                color: rgb(0, 100, 255);
-                box-shadow:
-                    inset 0 0 15px rgba(0, 100, 255, 0.6),
-                    inset 0 0 30px rgba(0, 100, 255, 0.4),
-                    0 0 20px rgb(0, 100, 255),
-                    0 0 40px rgb(0, 100, 255),
-                    0 0 60px rgb(0, 100, 255);
-                animation: pulse-glow 1.5s infinite ease-in-out;
-            }
-            .workspace-3:hover {
-                color: rgb(255, 215, 0);
-                box-shadow:
-                    inset 0 0 15px rgba(255, 215, 0, 0.6),
-                    inset 0 0 30px rgba(255, 215, 0, 0.4),
-                    0 0 20px rgb(255, 215, 0),
-                    0 0 40px rgb(255, 215, 0),
-                    0 0 60px rgb(255, 215, 0);
-                animation: pulse-glow 1.5s infinite ease-in-out;
-            }
-            .workspace-4:hover {
-                color: rgb(255, 235, 164);
-                box-shadow:
-                    inset 0 0 15px rgba(255, 255, 224, 0.6),
-                    inset 0 0 30px rgba(255, 255, 224, 0.4),
-                    0 0 20px rgb(255, 235, 164),
-                    0 0 40px rgb(255, 235, 164),
-                    0 0 60px rgb(255, 235, 164);
-                animation: pulse-glow 1.5s infinite ease-in-out;
-            }
-            .workspace-5:hover {
-                color: rgb(233, 28, 32);
-                box-shadow:
-                    inset 0 0 15px rgba(203, 28, 32, 0.6),
-                    inset 0 0 30px rgba(203, 28, 32, 0.4),
-                    0 0 20px rgb(233, 28, 32),
-                    0 0 40px rgb(233, 28, 32),
-                    0 0 60px rgb(233, 28, 32);
-                animation: pulse-glow 1.5s infinite ease-in-out;
-            }
-            .workspace-6:hover {
-                color: rgb(144, 238, 144);
-                box-shadow:
-                    inset 0 0 15px rgba(144, 238, 144, 0.6),
-                    inset 0 0 30px rgba(144, 238, 144, 0.4),
-                    0 0 20px rgb(144, 238, 144),
-                    0 0 40px rgb(144, 238, 144),
-                    0 0 60px rgb(144, 238, 144);
-                animation: pulse-glow 1.5s infinite ease-in-out;
-            }
-            .workspace-7:hover {
-                color: rgb(255, 182, 193);
-                box-shadow:
-                    inset 0 0 15px rgba(255, 182, 193, 0.6),
-                    inset 0 0 30px rgba(255, 182, 193, 0.4),
-                    0 0 20px rgb(255, 182, 193),
-                    0 0 40px rgb(255, 182, 193),
-                    0 0 60px rgb(255, 182, 193);
-                animation: pulse-glow 1.5s infinite ease-in-out;
-            }
-            .workspace-8:hover {
-                color: rgb(255, 255, 255);
+            .search-match {
                 box-shadow:
-                    inset 0 0 15px rgba(255, 255, 255, 0.6),
-                    inset 0 0 30px rgba(255, 255, 255, 0.4),
-                    0 0 20px rgb(255, 255, 255),
-                    0 0 40px rgb(255, 255, 255),
-                    0 0 60px rgb(255, 255, 255);
-                animation: pulse-glow 1.5s infinite ease-in-out;
-            }
-            .workspace-9:hover {
-                color: rgb(0, 255, 0);
-                box-shadow:
-                    inset 0 0 15px rgba(0, 255, 0, 0.6),
-                    inset 0 0 30px rgba(0, 255, 0, 0.4),
-                    0 0 20px rgb(0, 255, 0),
-                    0 0 40px rgb(0, 255, 0),
-                    0 0 60px rgb(0, 255, 0);
-                animation: pulse-glow 1.5s infinite ease-in-out;
-            }
-            .workspace-10:hover {
-                color: rgb(135, 206, 235);
-                box-shadow:
-                    inset 0 0 15px rgba(135, 206, 235, 0.6),
-                    inset 0 0 30px rgba(135, 206, 235, 0.4),
-                    0 0 20px rgb(135, 206, 235),
-                    0 0 40px rgb(135, 206, 235),
-                    0 0 60px rgb(135, 206, 235);
-                animation: pulse-glow 1.5s infinite ease-in-out;
-            }
-            .workspace-11:hover {
-                color: rgb(248, 248, 255);
-                box-shadow:
-                    inset 0 0 15px rgba(248, 248, 255, 0.6),
-                    inset 0 0 30px rgba(248, 248, 255, 0.4),
-                    0 0 20px rgb(248, 248, 255),
-                    0 0 40px rgb(248, 248, 255),
-                    0 0 60px rgb(248, 248, 255);
-                animation: pulse-glow 1.5s infinite ease-in-out;
-            }
-            .workspace-12:hover {
-                color: rgb(255, 192, 203);
-                box-shadow:
-                    inset 0 0 15px rgba(255, 192, 203, 0.6),
-                    inset 0 0 30px rgba(255, 192, 203, 0.4),
-                    0 0 20px rgb(255, 192, 203),
-                    0 0 40px rgb(255, 192, 203),
-                    0 0 60px rgb(255, 192, 203);
-                animation: pulse-glow 1.5s infinite ease-in-out;
-            }
-            .workspace-13:hover {
-                color: rgb(255, 20, 147);
-                box-shadow:
-                    inset 0 0 20px rgba(255, 20, 147, 0.7),
-                    inset 0 0 40px rgba(255, 20, 147, 0.5),
-                    0 0 30px rgb(255, 20, 147),
-                    0 0 60px rgb(255, 20, 147),
-                    0 0 90px rgb(255, 20, 147);
-                animation: pulse-glow 1.2s infinite ease-in-out;
+                    0 0 20px rgba(255, 255, 255, 0.8),
+                    0 0 40px rgba(255, 255, 255, 0.5);
+            }
+            .search-label {
+                color: white;
+                font-size: 16px;
+                text-shadow: 1px 1px 3px rgba(0, 0, 0, 0.8);
+            }
+            .page-indicator {
+                color: rgba(255, 255, 255, 0.8);
+                font-size: 16px;
+                text-shadow: 1px 1px 3px rgba(0, 0, 0, 0.8);
             }
             .app-icon {
                 background: transparent;
@@ -993,12 +2255,27 @@ public:
                 transform: scale(1.1);
                 box-shadow: 0 0 10px rgba(255, 255, 255, 0.5);
             }
+            .app-count {
+                background: rgba(0, 0, 0, 0.6);
+                border-radius: 6px;
+                color: white;
+                font-size: 9px;
+                padding: 0 3px;
+            }
+            .app-stale {
+                opacity: 0.45;
+            }
+            .app-overflow {
+                color: rgba(255, 255, 255, 0.8);
+                font-weight: bold;
+                font-size: 12px;
+                text-shadow: 1px 1px 3px rgba(0, 0, 0, 0.8);
+            }
             .tooltip-window {
                 background: rgba(0, 0, 0, 0);
                 border: 1px solid rgba(255, 255, 255, 0);
                 border-radius: 16px;
                 color: white;
-                font-family: ElysiaOSNew12;
                 font-size: 14px;
                 text-shadow: 1px 1px 3px rgba(0, 0, 0, 0.8);
             }
@@ -1006,13 +2283,175 @@ public:
                 background: transparent;
             }
         )";
+        std::string css = std::string(css_data) + theme.css;
         GtkCssProvider* provider = gtk_css_provider_new();
-        gtk_css_provider_load_from_data(provider, css_data, -1, nullptr);
+        gtk_css_provider_load_from_data(provider, css.c_str(), -1, nullptr);
+        bool first = !full_css_provider;
+        if (full_css_provider) {
+            gtk_style_context_remove_provider_for_screen(gdk_screen_get_default(),
+                                                         GTK_STYLE_PROVIDER(full_css_provider));
+            g_object_unref(full_css_provider);
+        }
         gtk_style_context_add_provider_for_screen(
             gdk_screen_get_default(),
             GTK_STYLE_PROVIDER(provider),
             GTK_STYLE_PROVIDER_PRIORITY_APPLICATION + 1 // Higher priority to override minimal CSS
         );
+        full_css_provider = provider; // Kept so a theme change can swap it out
+        if (low_power && first) {
+            apply_low_power_css();
+        }
+    }
+
+    // Watches the directories, not the files: editors and the theme switcher replace files by rename
+    void start_theme_watch() {
+        theme_watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (theme_watch_fd < 0) {
+            return;
+        }
+        const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE;
+        for (const std::string& path : {theme_file_path(), theme_selector_path()}) {
+            inotify_add_watch(theme_watch_fd, path.substr(0, path.find_last_of('/')).c_str(), mask);
+        }
+        theme_watch_id = g_unix_fd_add(theme_watch_fd, G_IO_IN, on_theme_changed_static, this);
+    }
+
+    void stop_theme_watch() {
+        if (theme_watch_id > 0) {
+            g_source_remove(theme_watch_id);
+            theme_watch_id = 0;
+        }
+        if (theme_watch_fd >= 0) {
+            close(theme_watch_fd);
+            theme_watch_fd = -1;
+        }
+        if (full_css_provider) {
+            g_object_unref(full_css_provider);
+            full_css_provider = nullptr;
+        }
+    }
+
+    void on_theme_changed() {
+        // Drain every queued event; one save can produce several
+        alignas(inotify_event) char buffer[4096];
+        bool relevant = false;
+        ssize_t n;
+        while ((n = read(theme_watch_fd, buffer, sizeof(buffer))) > 0) {
+            for (char* p = buffer; p < buffer + n;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+                if (event->len > 0) {
+                    std::string name = event->name;
+                    relevant |= name == "workspace-themes.ini" || name == "Light.txt";
+                }
+                p += sizeof(inotify_event) + event->len;
+            }
+        }
+        if (relevant) {
+            reload_theme();
+        }
+    }
+
+    void reload_theme() {
+        ThemeEngine::Resolved previous = theme;
+        load_theme();
+        if (theme.css != previous.css && full_css_provider) {
+            apply_full_css();
+        }
+        if (theme.icon_dir != previous.icon_dir) {
+            std::vector<int> visible(shown_ring_slots);
+            visible.push_back(special_slot);
+            for (int slot : visible) {
+                load_workspace_icon(slot);
+            }
+        }
+        if (verbose) {
+            std::cerr << "Theme: " << theme.name << std::endl;
+        }
+    }
+
+    // The index may appear later than the switcher starts, so the directory is watched for it.
+    // Publishing touches the index's attributes; PNG writes in the directory are not watched.
+    void start_preview_watch() {
+        std::string dir = "/tmp/workspace_previews";
+        preview_index.open_read(PreviewIndex::path(dir));
+        preview_index_generation = preview_index.generation();
+        preview_watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (preview_watch_fd < 0) {
+            return;
+        }
+        if (inotify_add_watch(preview_watch_fd, dir.c_str(), IN_ATTRIB | IN_CREATE) < 0) {
+            close(preview_watch_fd); // No recorder running
+            preview_watch_fd = -1;
+            return;
+        }
+        preview_watch_id = g_unix_fd_add(preview_watch_fd, G_IO_IN, on_preview_index_changed_static, this);
+    }
+
+    void stop_preview_watch() {
+        if (preview_watch_id > 0) {
+            g_source_remove(preview_watch_id);
+            preview_watch_id = 0;
+        }
+        if (preview_watch_fd >= 0) {
+            close(preview_watch_fd);
+            preview_watch_fd = -1;
+        }
+        preview_index.close();
+    }
+
+    void on_preview_index_changed() {
+        alignas(inotify_event) char buffer[4096];
+        bool relevant = false;
+        ssize_t n;
+        while ((n = read(preview_watch_fd, buffer, sizeof(buffer))) > 0) {
+            for (char* p = buffer; p < buffer + n;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+                relevant |= event->len > 0 && std::string(event->name) == "index";
+                p += sizeof(inotify_event) + event->len;
+            }
+        }
+        if (!relevant) {
+            return;
+        }
+        if (!preview_index.is_open() && !preview_index.open_read(PreviewIndex::path("/tmp/workspace_previews"))) {
+            return;
+        }
+        uint64_t generation = preview_index.generation();
+        if (generation == preview_index_generation) {
+            return;
+        }
+        preview_index_generation = generation;
+        // Unchanged workspaces hit the cache under their old generation
+        if (live_thumbnails) {
+            std::vector<int> visible(shown_ring_slots);
+            visible.push_back(special_slot);
+            for (int slot : visible) {
+                load_workspace_icon(slot);
+            }
+        }
+        if (hovered_workspace && needs_thumbnail(hovered_workspace) &&
+            !tooltip_jobs_pending.count(hovered_workspace)) {
+            queue_tooltip_job(make_tooltip_job(hovered_workspace, tooltip_generation.load()));
+        }
+    }
+
+    // Hover keeps its glow as a static shadow; nothing animates, so an idle overlay
+    // with a hovered button stops redrawing
+    void apply_low_power_css() {
+        const char* low_power_css = R"(
+            .workspace-button, .workspace-button:hover, .workspace-button:active,
+            .workspace-icon, .workspace-live, .app-icon, .app-icon:hover {
+                animation: none;
+                transition: none;
+            }
+        )";
+        GtkCssProvider* provider = gtk_css_provider_new();
+        gtk_css_provider_load_from_data(provider, low_power_css, -1, nullptr);
+        gtk_style_context_add_provider_for_screen(
+            gdk_screen_get_default(),
+            GTK_STYLE_PROVIDER(provider),
+            GTK_STYLE_PROVIDER_PRIORITY_APPLICATION + 2
+        );
         g_object_unref(provider);
     }
 
@@ -1021,15 +2460,19 @@ public:
     }
 };
 
+GPollFunc WorkspaceSwitcher::default_poll_func = nullptr;
+uint64_t WorkspaceSwitcher::main_loop_wakeups = 0;
+
 // Static callbacks
 gboolean WorkspaceSwitcher::load_workspace_icons_async_static(gpointer user_data) {
     WorkspaceSwitcher* self = static_cast<WorkspaceSwitcher*>(user_data);
     return self->load_workspace_icons_async();
 }
 
-gboolean WorkspaceSwitcher::load_app_icons_async_static(gpointer user_data) {
+gboolean WorkspaceSwitcher::on_snapshot_ready_static(gpointer user_data) {
     WorkspaceSwitcher* self = static_cast<WorkspaceSwitcher*>(user_data);
-    return self->load_app_icons_async();
+    self->apply_snapshot();
+    return FALSE; // Run once
 }
 
 gboolean WorkspaceSwitcher::fade_in_timeout_static(gpointer user_data) {
@@ -1037,6 +2480,122 @@ gboolean WorkspaceSwitcher::fade_in_timeout_static(gpointer user_data) {
     return self->fade_in_timeout();
 }
 
+gboolean WorkspaceSwitcher::on_motion_notify_static(GtkWidget* widget, GdkEventMotion* event, gpointer user_data) {
+    (void)widget;
+    WorkspaceSwitcher* self = static_cast<WorkspaceSwitcher*>(user_data);
+    self->on_pointer_motion(event->x, event->y, event->time);
+    return FALSE;
+}
+
+gboolean WorkspaceSwitcher::on_scroll_static(GtkWidget* widget, GdkEventScroll* event, gpointer user_data) {
+    (void)widget;
+    WorkspaceSwitcher* self = static_cast<WorkspaceSwitcher*>(user_data);
+    if (event->direction == GDK_SCROLL_DOWN) {
+        self->turn_page(1);
+    } else if (event->direction == GDK_SCROLL_UP) {
+        self->turn_page(-1);
+    }
+    return FALSE;
+}
+
+void WorkspaceSwitcher::on_scale_factor_changed_static(GObject* object, GParamSpec* pspec, gpointer user_data) {
+    (void)object;
+    (void)pspec;
+    WorkspaceSwitcher* self = static_cast<WorkspaceSwitcher*>(user_data);
+    self->on_scale_factor_changed();
+}
+
+gboolean WorkspaceSwitcher::on_first_draw_static(GtkWidget* widget, cairo_t* cr, gpointer user_data) {
+    (void)widget;
+    (void)cr;
+    WorkspaceSwitcher* self = static_cast<WorkspaceSwitcher*>(user_data);
+    self->on_first_draw();
+    return FALSE; // Let the normal draw continue
+}
+
+void WorkspaceSwitcher::on_drag_begin_static(GtkWidget* widget, GdkDragContext* context, gpointer user_data) {
+    WorkspaceSwitcher* self = static_cast<WorkspaceSwitcher*>(user_data);
+    self->hide_tooltip();
+    // App icons drag their own image; buttons keep the default icon
+    if (GTK_IS_EVENT_BOX(widget)) {
+        cairo_surface_t* surface = nullptr;
+        g_object_get(gtk_bin_get_child(GTK_BIN(widget)), "surface", &surface, nullptr);
+        if (surface) {
+            gtk_drag_set_icon_surface(context, surface);
+            cairo_surface_destroy(surface);
+        }
+    }
+}
+
+void WorkspaceSwitcher::on_drag_data_get_static(GtkWidget* widget, GdkDragContext* context, GtkSelectionData* data,
+                                                guint info, guint time, gpointer user_data) {
+    (void)context;
+    (void)info;
+    (void)time;
+    (void)user_data;
+    int slot = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(widget), "workspace"));
+    const char* app_class = static_cast<const char*>(g_object_get_data(G_OBJECT(widget), "app-class"));
+    std::string payload = std::to_string(slot) + "\n" + (app_class ? app_class : "");
+    gtk_selection_data_set(data, gtk_selection_data_get_target(data), 8,
+                           reinterpret_cast<const guchar*>(payload.data()), static_cast<gint>(payload.size()));
+}
+
+void WorkspaceSwitcher::on_drag_data_received_static(GtkWidget* widget, GdkDragContext* context, gint x, gint y,
+                                                     GtkSelectionData* data, guint info, guint time,
+                                                     gpointer user_data) {
+    (void)x;
+    (void)y;
+    (void)info;
+    WorkspaceSwitcher* self = static_cast<WorkspaceSwitcher*>(user_data);
+    const guchar* bytes = gtk_selection_data_get_data(data);
+    gint length = gtk_selection_data_get_length(data);
+    if (!bytes || length <= 0) {
+        gtk_drag_finish(context, FALSE, FALSE, time);
+        return;
+    }
+    std::string payload(reinterpret_cast<const char*>(bytes), static_cast<size_t>(length));
+    size_t newline = payload.find('\n');
+    int from_slot = std::atoi(payload.c_str());
+    std::string app_class = newline == std::string::npos ? "" : payload.substr(newline + 1);
+    int to_slot = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(widget), "workspace"));
+    GdkModifierType state = static_cast<GdkModifierType>(0);
+    gtk_get_current_event_state(&state);
+    self->input_time = std::chrono::steady_clock::now();
+    self->handle_drop(from_slot, app_class, to_slot, state & GDK_SHIFT_MASK);
+    gtk_drag_finish(context, TRUE, FALSE, time);
+}
+
+gboolean WorkspaceSwitcher::on_theme_changed_static(gint fd, GIOCondition condition, gpointer user_data) {
+    (void)fd;
+    (void)condition;
+    WorkspaceSwitcher* self = static_cast<WorkspaceSwitcher*>(user_data);
+    self->on_theme_changed();
+    return G_SOURCE_CONTINUE;
+}
+
+gboolean WorkspaceSwitcher::on_preview_index_changed_static(gint fd, GIOCondition condition, gpointer user_data) {
+    (void)fd;
+    (void)condition;
+    WorkspaceSwitcher* self = static_cast<WorkspaceSwitcher*>(user_data);
+    self->on_preview_index_changed();
+    return G_SOURCE_CONTINUE;
+}
+
+gboolean WorkspaceSwitcher::on_control_ready_static(gint fd, GIOCondition condition, gpointer user_data) {
+    (void)fd;
+    (void)condition;
+    WorkspaceSwitcher* self = static_cast<WorkspaceSwitcher*>(user_data);
+    self->on_control_ready();
+    return G_SOURCE_CONTINUE;
+}
+
+gboolean WorkspaceSwitcher::on_tooltip_result_static(gpointer user_data) {
+    TooltipResult* result = static_cast<TooltipResult*>(user_data);
+    result->self->apply_tooltip_result(result);
+    delete result;
+    return FALSE; // Run once
+}
+
 // --- MODIFIED on_button_enter_static ---
 gboolean WorkspaceSwitcher::on_button_enter_static(GtkWidget* button, GdkEventCrossing* event, gpointer user_data) {
     (void)event;
@@ -1045,7 +2604,7 @@ gboolean WorkspaceSwitcher::on_button_enter_static(GtkWidget* button, GdkEventCr
     // Only show tooltip if fade-in is complete for better performance
     if (!self->fade_in_complete) return FALSE;
     gint tooltip_x, tooltip_y;
-    if (workspace == 13) {
+    if (workspace == special_slot) {
         // For workspace 13 (center), position tooltip anchor point BELOW the center button
         tooltip_x = self->center_x;
         // Anchor point is at the bottom edge of the special button
@@ -1076,6 +2635,8 @@ gboolean WorkspaceSwitcher::on_button_leave_static(GtkWidget* button, GdkEventCr
 void WorkspaceSwitcher::on_workspace_click_static(GtkWidget* button, gpointer user_data) {
     WorkspaceSwitcher* self = static_cast<WorkspaceSwitcher*>(user_data);
     int workspace = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(button), "workspace"));
+    self->input_time = std::chrono::steady_clock::now();
+    self->input_from_key = false;
     self->switch_workspace(workspace);
     gtk_main_quit();
 }
@@ -1093,15 +2654,58 @@ void WorkspaceSwitcher::on_destroy_static(GtkWidget* widget, gpointer user_data)
     gtk_main_quit();
 }
 
+static SwitcherOptions parse_options(int argc, char* argv[]) {
+    SwitcherOptions options;
+    const char* runtime_dir = getenv("XDG_RUNTIME_DIR");
+    options.metrics_path = std::string(runtime_dir && *runtime_dir ? runtime_dir : "/tmp") +
+                           "/ely-workspace-switcher-metrics.json";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--cache-budget=", 0) == 0) {
+            options.cache_budget_bytes = std::strtoul(arg.c_str() + 15, nullptr, 10) * 1024 * 1024;
+        } else if (arg.rfind("--metrics=", 0) == 0) {
+            options.metrics_path = arg.substr(10);
+        } else if (arg == "--power=auto") {
+            options.power_mode = SwitcherOptions::POWER_AUTO;
+        } else if (arg == "--power=low") {
+            options.power_mode = SwitcherOptions::POWER_LOW;
+        } else if (arg == "--power=normal") {
+            options.power_mode = SwitcherOptions::POWER_NORMAL;
+        } else if (arg == "--live-thumbnails") {
+            options.live_thumbnails = true;
+        } else if (arg == "--exit-on-first-frame") {
+            options.exit_on_first_frame = true;
+        } else if (arg == "--verbose") {
+            options.verbose = true;
+        } else if (arg == "--preview=auto") {
+            options.preview_mode = SwitcherOptions::PREVIEW_AUTO;
+        } else if (arg == "--preview=capture") {
+            options.preview_mode = SwitcherOptions::PREVIEW_CAPTURE;
+        } else if (arg == "--preview=minimap") {
+            options.preview_mode = SwitcherOptions::PREVIEW_MINIMAP;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+        }
+    }
+    return options;
+}
+
 int main(int argc, char* argv[]) {
+    auto started = std::chrono::steady_clock::now(); // Before GTK setup, for open_to_first_frame
     gtk_init(&argc, &argv);
+    SwitcherOptions options = parse_options(argc, argv);
+    if (options.power_mode == SwitcherOptions::POWER_AUTO) {
+        options.power_mode = PowerState::prefers_low_power() ? SwitcherOptions::POWER_LOW
+                                                             : SwitcherOptions::POWER_NORMAL;
+    }
     // Optimize GTK settings for maximum performance
     g_object_set(gtk_settings_get_default(),
-                 "gtk-enable-animations", TRUE,
+                 "gtk-enable-animations", options.power_mode == SwitcherOptions::POWER_LOW ? FALSE : TRUE,
                  "gtk-animation-duration", 5, // Ultra-fast animations
                  "gtk-double-click-time", 200, // Faster double-clicks
                  nullptr);
-    WorkspaceSwitcher app;
+    options.started = started;
+    WorkspaceSwitcher app(options);
     app.run();
     return 0;
 }
\ No newline at end of file
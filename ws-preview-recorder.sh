@@ -18,6 +18,10 @@ THUMB_HEIGHT=768
 # Store last image hash per workspace
 declare -A last_hashes
 
+# Optional helper that writes the per-size preview pyramid the switcher loads as is,
+# and publishes each capture's generation in $DIR/index for the switcher to check
+PYRAMID_TOOL=$(command -v ws-preview-tool || true)
+
 while true; do
     id=$(hyprctl -j activeworkspace | jq -r '.id' 2>/dev/null || echo "")
     now=$(date +%s)
@@ -39,6 +43,14 @@ while true; do
                 mv "$TMP_IMG" "$out"
                 last_hashes[$id]="$new_hash"
                 echo "[ws-preview] Captured workspace $id -> $out (changed)"
+                if [[ -n "$PYRAMID_TOOL" ]]; then
+                    monitor=$(hyprctl -j monitors | jq -r '.[] | select(.focused) | "\(.width) \(.height) \(.scale)"' 2>/dev/null || echo "")
+                    if [[ -n "$monitor" ]]; then
+                        "$PYRAMID_TOOL" pyramid "$out" "$id" ${=monitor} || echo "[ws-preview] pyramid failed for workspace $id" >&2
+                    else
+                        "$PYRAMID_TOOL" publish "$out" "$id" || echo "[ws-preview] publish failed for workspace $id" >&2
+                    fi
+                fi
             else
                 echo "[ws-preview] Skipped workspace $id (unchanged)"
             fi
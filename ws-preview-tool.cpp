@@ -0,0 +1,106 @@
+// Recorder helper: turns one workspace capture into the preview pyramid the
+// switcher loads without rescaling.
+//
+//   ws-preview-tool pyramid <capture.png> <workspace-id> <width> <height> <scale>
+//   ws-preview-tool publish <capture.png> <workspace-id>
+//
+// width, height and scale describe the focused monitor as Hyprland reports it
+// (device pixels and fractional scale). pyramid publishes the capture in the
+// preview index once its levels are written; publish does only that, for
+// captures made without a pyramid.
+#include <gdk-pixbuf/gdk-pixbuf.h>
+#include <sys/stat.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "preview-index.hpp"
+#include "preview-pyramid.hpp"
+
+// Writes next to the target and renames, so the switcher never reads a partial file
+static bool save_level(GdkPixbuf* pixbuf, const std::string& path) {
+    std::string tmp_path = path + ".tmp";
+    GError* error = nullptr;
+    if (!gdk_pixbuf_save(pixbuf, tmp_path.c_str(), "png", &error, "compression", "1", nullptr)) {
+        std::cerr << "Error saving " << tmp_path << ": " << error->message << std::endl;
+        g_error_free(error);
+        return false;
+    }
+    return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+// New generation for the workspace, stamped with the capture's modification time
+static int publish_capture(const std::string& capture_path, int workspace_id) {
+    struct stat st;
+    if (stat(capture_path.c_str(), &st) != 0) {
+        std::cerr << "Error reading " << capture_path << std::endl;
+        return 1;
+    }
+    std::string dir = capture_path.substr(0, capture_path.find_last_of('/'));
+    PreviewIndex index;
+    if (!index.open_write(PreviewIndex::path(dir))) {
+        std::cerr << "Error opening " << PreviewIndex::path(dir) << std::endl;
+        return 1;
+    }
+    int64_t content_time_ns = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    if (index.publish(workspace_id, content_time_ns) == 0) {
+        std::cerr << "Preview index full, workspace " << workspace_id << " not published" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+static int build_pyramid(const std::string& capture_path, int workspace_id, int device_width, int device_height,
+                         double compositor_scale) {
+    GError* error = nullptr;
+    GdkPixbuf* source = gdk_pixbuf_new_from_file(capture_path.c_str(), &error);
+    if (!source) {
+        std::cerr << "Error loading " << capture_path << ": " << error->message << std::endl;
+        g_error_free(error);
+        return 1;
+    }
+    // GTK3 works in logical pixels with an integer scale, fractional outputs round up
+    int scale = std::max(1, static_cast<int>(std::ceil(compositor_scale)));
+    int screen_width = static_cast<int>(std::lround(device_width / compositor_scale));
+    int screen_height = static_cast<int>(std::lround(device_height / compositor_scale));
+    std::string dir = capture_path.substr(0, capture_path.find_last_of('/'));
+    int failures = 0;
+    // Largest level first; each smaller one is scaled from the previous, not the full capture
+    static const PreviewPyramid::Level order[] = {PreviewPyramid::TOOLTIP, PreviewPyramid::CENTER,
+                                                  PreviewPyramid::BUTTON};
+    GdkPixbuf* previous = GDK_PIXBUF(g_object_ref(source));
+    for (PreviewPyramid::Level level : order) {
+        int box_width, box_height, width, height;
+        PreviewPyramid::level_box(level, screen_width, screen_height, box_width, box_height);
+        PreviewPyramid::fit(gdk_pixbuf_get_width(source), gdk_pixbuf_get_height(source), box_width * scale,
+                            box_height * scale, width, height);
+        GdkPixbuf* scaled = gdk_pixbuf_scale_simple(previous, width, height, GDK_INTERP_BILINEAR);
+        if (!scaled || !save_level(scaled, PreviewPyramid::level_path(dir, workspace_id, level, scale))) {
+            failures++;
+        }
+        if (scaled) {
+            g_object_unref(previous);
+            previous = scaled;
+        }
+    }
+    g_object_unref(previous);
+    g_object_unref(source);
+    // Published even with a missing level: tooltips fall back to the full capture, live ring
+    // buttons to the theme icon
+    failures += publish_capture(capture_path, workspace_id);
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 7 && std::string(argv[1]) == "pyramid") {
+        return build_pyramid(argv[2], std::atoi(argv[3]), std::atoi(argv[4]), std::atoi(argv[5]),
+                             std::max(1.0, std::atof(argv[6])));
+    }
+    if (argc == 4 && std::string(argv[1]) == "publish") {
+        return publish_capture(argv[2], std::atoi(argv[3]));
+    }
+    std::cerr << "Usage: " << argv[0] << " pyramid <capture.png> <workspace-id> <width> <height> <scale>" << std::endl;
+    std::cerr << "       " << argv[0] << " publish <capture.png> <workspace-id>" << std::endl;
+    return 2;
+}